@@ -0,0 +1,764 @@
+// Benchmarks de core_numeric
+// Compilar: g++ -std=c++20 -O2 -pthread bench.cpp -o bench
+// Uso:
+//   ./bench [suite] [--max-bytes N] [--json archivo] [--counters]
+//       Todos los algoritmos, tipos de int8 a double y Vector3D, tamaños desde L1 hasta 4 GB
+//       (limitado a la memoria libre) y distribuciones aleatoria, ordenada y adversaria.
+//       Imprime ns/elemento, GB/s y % del ancho de banda medido; el JSON va a bench_output.json.
+//       Con --counters añade contadores de hardware (ciclos, instrucciones, fallos de L1 y LLC,
+//       fallos de salto y ciclos parados) por perf_event_open, si el sistema lo permite
+//   ./bench pool
+//       Latencia de sum, variance y max paralelos (pool persistente) contra la version serie y contra
+//       crear hilos en cada llamada, de 1k a 1M doubles, y el costo de un fork-join vacio
+//   ./bench scaling [elementos] [archivo]
+//       Escalabilidad de las politicas paralelas (por defecto 2^25 doubles, 256 MB) y columna en disco
+//       (se escribe en bench_columna.bin y se borra al terminar)
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <functional>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <span>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include "core_numeric.h"
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+// Evita que el compilador elimine un resultado que no se usa
+template <typename T>
+void no_optimizar(const T& valor) {
+    asm volatile("" : : "g"(&valor) : "memory");
+}
+
+// Mejor tiempo (en ms) de varias repeticiones
+double medir_ms(const std::function<void()>& funcion, int repeticiones = 5) {
+    double mejor = 1e300;
+    for (int r = 0; r < repeticiones; ++r) {
+        auto inicio = std::chrono::steady_clock::now();
+        funcion();
+        auto fin = std::chrono::steady_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(fin - inicio).count();
+        if (ms < mejor) mejor = ms;
+    }
+    return mejor;
+}
+
+// Mejor tiempo por llamada (en ns). Las llamadas cortas se agrupan en lotes de al menos 1 ms para que
+// la resolucion del reloj no cuente, y se repiten lotes hasta juntar 'minimo_ms' (al menos 3 lotes)
+double medir_ns(const std::function<void()>& funcion, double minimo_ms = 30.0) {
+    using reloj = std::chrono::steady_clock;
+    auto inicio = reloj::now();
+    funcion();
+    double primera = std::chrono::duration<double, std::nano>(reloj::now() - inicio).count();
+    std::size_t por_lote = primera < 1e6 ? static_cast<std::size_t>(1e6 / (primera + 1.0)) + 1 : 1;
+
+    double mejor = primera;
+    double total = 0;
+    for (int lote = 0; lote < 3 || total < minimo_ms * 1e6; ++lote) {
+        auto desde = reloj::now();
+        for (std::size_t i = 0; i < por_lote; ++i) {
+            funcion();
+        }
+        double ns = std::chrono::duration<double, std::nano>(reloj::now() - desde).count();
+        total += ns;
+        if (ns / por_lote < mejor) mejor = ns / por_lote;
+    }
+    return mejor;
+}
+
+// CONTADORES:
+
+// Contadores de hardware con perf_event_open (solo Linux). Cada evento se abre por separado y no en grupo:
+// un grupo falla entero si falta un evento, y los ciclos parados no existen en muchas CPUs.
+// Solo se cuenta el espacio de usuario, que es lo que permite perf_event_paranoid <= 2 sin privilegios.
+// Si no se abre ninguno (paranoid 3, contenedores sin permiso, maquinas virtuales sin PMU) la suite
+// sigue midiendo solo tiempo
+class Contadores {
+public:
+    static constexpr std::size_t total = 7;
+    static constexpr const char* nombres[total] = {
+        "cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses", "stalled_cycles_frontend",
+        "stalled_cycles_backend",
+    };
+
+    // Cuentas por llamada; NaN en los eventos que no se pudieron abrir
+    using Lectura = std::array<double, total>;
+
+    Contadores() {
+        descriptores.fill(-1);
+#if defined(__linux__)
+        constexpr auto cache = [](std::uint64_t nivel) {
+            return nivel | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        };
+        const std::pair<std::uint32_t, std::uint64_t> eventos[total] = {
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+            {PERF_TYPE_HW_CACHE, cache(PERF_COUNT_HW_CACHE_L1D)},
+            {PERF_TYPE_HW_CACHE, cache(PERF_COUNT_HW_CACHE_LL)},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_STALLED_CYCLES_FRONTEND},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_STALLED_CYCLES_BACKEND},
+        };
+        for (std::size_t e = 0; e < total; ++e) {
+            perf_event_attr atributos;
+            std::memset(&atributos, 0, sizeof(atributos));
+            atributos.size = sizeof(atributos);
+            atributos.type = eventos[e].first;
+            atributos.config = eventos[e].second;
+            atributos.disabled = 1;
+            atributos.exclude_kernel = 1;
+            atributos.exclude_hv = 1;
+            // Con mas eventos que contadores fisicos el kernel los multiplexa: se escala con estos tiempos
+            atributos.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            long fd = ::syscall(SYS_perf_event_open, &atributos, 0, -1, -1, 0);
+            if (fd >= 0) {
+                descriptores[e] = static_cast<int>(fd);
+            } else if (motivo_.empty()) {
+                motivo_ = std::string(nombres[e]) + ": " + std::strerror(errno);
+                if (errno == EACCES || errno == EPERM) {
+                    motivo_ += " (revisar /proc/sys/kernel/perf_event_paranoid)";
+                }
+            }
+        }
+#else
+        motivo_ = "perf_event_open solo existe en Linux";
+#endif
+    }
+
+    ~Contadores() {
+#if defined(__linux__)
+        for (int fd : descriptores) {
+            if (fd >= 0) ::close(fd);
+        }
+#endif
+    }
+
+    Contadores(const Contadores&) = delete;
+    Contadores& operator=(const Contadores&) = delete;
+
+    bool disponible(std::size_t evento) const { return descriptores[evento] >= 0; }
+
+    bool alguno() const {
+        for (std::size_t e = 0; e < total; ++e) {
+            if (disponible(e)) return true;
+        }
+        return false;
+    }
+
+    // Primer error al abrir un evento, vacio si se abrieron todos
+    const std::string& motivo() const { return motivo_; }
+
+    // Cuenta 'repeticiones' llamadas a 'funcion' y devuelve la media por llamada
+    template <typename F>
+    Lectura medir(F&& funcion, std::size_t repeticiones) {
+        Lectura lectura;
+        lectura.fill(std::numeric_limits<double>::quiet_NaN());
+#if defined(__linux__)
+        for (int fd : descriptores) {
+            if (fd >= 0) {
+                ::ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+        for (std::size_t i = 0; i < repeticiones; ++i) {
+            funcion();
+        }
+        for (int fd : descriptores) {
+            if (fd >= 0) ::ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        }
+        for (std::size_t e = 0; e < total; ++e) {
+            std::uint64_t valores[3];  // cuenta, tiempo habilitado, tiempo contando
+            if (descriptores[e] < 0 || ::read(descriptores[e], valores, sizeof(valores)) != sizeof(valores) ||
+                valores[2] == 0) {
+                continue;
+            }
+            double escala = static_cast<double>(valores[1]) / static_cast<double>(valores[2]);
+            lectura[e] = static_cast<double>(valores[0]) * escala / static_cast<double>(repeticiones);
+        }
+#else
+        (void)funcion;
+        (void)repeticiones;
+#endif
+        return lectura;
+    }
+
+private:
+    std::array<int, total> descriptores;
+    std::string motivo_;
+};
+
+// Hilos a probar: 1, 2, 4, ... hasta el numero de hilos de hardware (incluido)
+std::vector<unsigned> hilos_a_probar() {
+    unsigned maximo = std::thread::hardware_concurrency();
+    if (maximo == 0) maximo = 1;
+    std::vector<unsigned> hilos;
+    for (unsigned h = 1; h < maximo; h *= 2) {
+        hilos.push_back(h);
+    }
+    hilos.push_back(maximo);
+    return hilos;
+}
+
+// Vector3D como en test.cpp: el tipo de usuario que recorre los caminos genericos (sin kernels)
+struct Vector3D {
+    double x, y, z;
+
+    Vector3D(double _x = 0, double _y = 0, double _z = 0) : x(_x), y(_y), z(_z) {}
+
+    Vector3D operator+(const Vector3D& otro) const { return Vector3D(x + otro.x, y + otro.y, z + otro.z); }
+    Vector3D operator-(const Vector3D& otro) const { return Vector3D(x - otro.x, y - otro.y, z - otro.z); }
+    Vector3D operator*(const Vector3D& otro) const { return Vector3D(x * otro.x, y * otro.y, z * otro.z); }
+    Vector3D operator/(std::size_t n) const { return Vector3D(x / n, y / n, z / n); }
+    bool operator>(const Vector3D& otro) const {
+        return (x * x + y * y + z * z) > (otro.x * otro.x + otro.y * otro.y + otro.z * otro.z);
+    }
+};
+
+// SUITE:
+
+// Generador xorshift64*: llenar varios GB con mt19937 tarda mas que medirlos
+struct Generador {
+    std::uint64_t estado;
+    std::uint64_t operator()() {
+        estado ^= estado >> 12;
+        estado ^= estado << 25;
+        estado ^= estado >> 27;
+        return estado * 2685821657736338717ULL;
+    }
+    // Uniforme en [0, 1)
+    double uniforme() { return static_cast<double>((*this)() >> 11) * 0x1.0p-53; }
+};
+
+// aleatoria: uniforme en todo el rango de los enteros, en [-1000, 1000) en los flotantes.
+// ordenada: rampa creciente, el peor caso de max/argmax escalares (el maximo cambia en cada elemento).
+// adversaria: enteros alternando el minimo y el maximo del tipo (desborda cualquier suma sin ensanchar);
+// flotantes subnormales, que en muchas CPUs pasan por microcodigo y hunden el rendimiento
+enum class Distribucion { aleatoria, ordenada, adversaria };
+
+const char* nombre_distribucion(Distribucion d) {
+    switch (d) {
+        case Distribucion::aleatoria: return "random";
+        case Distribucion::ordenada: return "sorted";
+        case Distribucion::adversaria: return "adversarial";
+    }
+    return "?";
+}
+
+template <typename T>
+struct Tipo;
+
+template <> struct Tipo<std::int8_t> { static constexpr const char* nombre = "int8"; };
+template <> struct Tipo<std::int16_t> { static constexpr const char* nombre = "int16"; };
+template <> struct Tipo<std::int32_t> { static constexpr const char* nombre = "int32"; };
+template <> struct Tipo<std::int64_t> { static constexpr const char* nombre = "int64"; };
+template <> struct Tipo<float> { static constexpr const char* nombre = "float"; };
+template <> struct Tipo<double> { static constexpr const char* nombre = "double"; };
+template <> struct Tipo<Vector3D> { static constexpr const char* nombre = "Vector3D"; };
+
+// Valor del elemento i de n para cada distribucion
+template <typename T>
+T generar(Distribucion d, std::size_t i, std::size_t n, Generador& generador) {
+    if constexpr (std::same_as<T, Vector3D>) {
+        return Vector3D(generar<double>(d, i, n, generador), generar<double>(d, i, n, generador),
+                        generar<double>(d, i, n, generador));
+    } else if constexpr (std::is_integral_v<T>) {
+        using L = std::numeric_limits<T>;
+        switch (d) {
+            case Distribucion::aleatoria:
+                return static_cast<T>(generador());
+            case Distribucion::ordenada: {
+                long double paso = (static_cast<long double>(L::max()) - L::min()) / (n > 1 ? n - 1 : 1);
+                return static_cast<T>(L::min() + paso * i);
+            }
+            case Distribucion::adversaria:
+                return i % 2 == 0 ? L::max() : L::min();
+        }
+        return T{};
+    } else {
+        switch (d) {
+            case Distribucion::aleatoria:
+                return static_cast<T>(-1000.0 + 2000.0 * generador.uniforme());
+            case Distribucion::ordenada:
+                return static_cast<T>(-1000.0 + 2000.0 * static_cast<double>(i) / static_cast<double>(n));
+            case Distribucion::adversaria: {
+                T subnormal = std::numeric_limits<T>::denorm_min() * static_cast<T>(1 + generador() % 1000);
+                return i % 2 == 0 ? subnormal : -subnormal;
+            }
+        }
+        return T{};
+    }
+}
+
+// Una medicion de la suite
+struct Resultado {
+    std::string algoritmo;
+    std::string tipo;
+    std::string distribucion;
+    std::size_t elementos = 0;
+    std::size_t bytes = 0;
+    double ns_elemento = 0;
+    double gbs = 0;
+    double porcentaje = 0;
+    bool con_contadores = false;
+    Contadores::Lectura contadores{};  // Por elemento
+};
+
+// Ancho de banda de lectura de referencia para 'bytes' bytes ya en memoria: el mejor entre un XOR de
+// palabras de 64 bits (un bucle que solo espera a la memoria, compilado sin -march) y sum de los mismos
+// bytes como int32 y como float con los kernels del ISA activo. Se mide con el mismo tamaño que cada caso, asi el
+// porcentaje compara contra el nivel de cache (o la RAM) donde viven esos datos
+double ancho_de_banda(const void* datos, std::size_t bytes) {
+    const auto* palabras = static_cast<const std::uint64_t*>(datos);
+    const std::size_t n = bytes / sizeof(std::uint64_t);
+    double ns_xor = medir_ns([&] {
+        std::uint64_t a0 = 0, a1 = 0, a2 = 0, a3 = 0;
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            a0 ^= palabras[i];
+            a1 ^= palabras[i + 1];
+            a2 ^= palabras[i + 2];
+            a3 ^= palabras[i + 3];
+        }
+        for (; i < n; ++i) {
+            a0 ^= palabras[i];
+        }
+        no_optimizar(a0 ^ a1 ^ a2 ^ a3);
+    });
+    std::span<const std::int32_t> enteros(static_cast<const std::int32_t*>(datos), n * 2);
+    std::span<const float> flotantes(static_cast<const float*>(datos), n * 2);
+    double ns_enteros = medir_ns([&] { no_optimizar(core_numeric::sum(enteros)); });
+    double ns_flotantes = medir_ns([&] { no_optimizar(core_numeric::sum(flotantes)); });
+    return (n * sizeof(std::uint64_t)) / std::min({ns_xor, ns_enteros, ns_flotantes});
+}
+
+// Algoritmos medidos sobre un vector de T
+template <typename T>
+std::vector<std::pair<std::string, std::function<void(const std::vector<T>&)>>> algoritmos() {
+    std::vector<std::pair<std::string, std::function<void(const std::vector<T>&)>>> lista = {
+        {"sum", [](const std::vector<T>& v) { no_optimizar(core_numeric::sum(v)); }},
+        {"mean", [](const std::vector<T>& v) { no_optimizar(core_numeric::mean(v)); }},
+        {"variance", [](const std::vector<T>& v) { no_optimizar(core_numeric::variance(v)); }},
+        {"max", [](const std::vector<T>& v) { no_optimizar(core_numeric::max(v)); }},
+        {"min", [](const std::vector<T>& v) { no_optimizar(core_numeric::min(v)); }},
+        {"argmax", [](const std::vector<T>& v) { no_optimizar(core_numeric::argmax(v)); }},
+        {"transform_reduce", [](const std::vector<T>& v) {
+            no_optimizar(core_numeric::transform_reduce(v, [](const T& x) { return x * x; }));
+        }},
+        {"dot", [](const std::vector<T>& v) { no_optimizar(core_numeric::dot(v, v)); }},
+        {"describe", [](const std::vector<T>& v) { no_optimizar(core_numeric::describe(v)); }},
+    };
+    return lista;
+}
+
+// Columnas de contadores: ciclos, instrucciones por ciclo, fallos de L1, LLC y salto por cada 1000
+// elementos (ke) y ciclos parados (frontend + backend) en % de los ciclos. '-' si el evento no esta disponible
+void imprimir_contadores(const Contadores::Lectura& c) {
+    auto columna = [](double valor, int ancho, int decimales) {
+        if (std::isnan(valor)) {
+            std::cout << std::setw(ancho) << "-";
+        } else {
+            std::cout << std::setw(ancho) << std::fixed << std::setprecision(decimales) << valor;
+        }
+    };
+    columna(c[0], 10, 3);
+    columna(c[1] / c[0], 7, 2);
+    columna(c[2] * 1000, 10, 2);
+    columna(c[3] * 1000, 10, 2);
+    columna(c[4] * 1000, 10, 2);
+    columna(100.0 * (c[5] + c[6]) / c[0], 9, 1);
+}
+
+// Mide todos los algoritmos para T en cada tamaño y distribucion
+template <typename T>
+void medir_tipo(const std::vector<std::size_t>& tamaños, std::map<std::size_t, double>& referencia,
+                Contadores* contadores, std::vector<Resultado>& resultados) {
+    const Distribucion distribuciones[] = {Distribucion::aleatoria, Distribucion::ordenada, Distribucion::adversaria};
+    auto lista = algoritmos<T>();
+    for (std::size_t bytes_objetivo : tamaños) {
+        const std::size_t n = bytes_objetivo / sizeof(T);
+        if (n == 0) continue;
+        const std::size_t bytes = n * sizeof(T);
+        std::vector<T> datos(n);
+        Generador generador{0x9E3779B97F4A7C15ULL};
+
+        for (Distribucion d : distribuciones) {
+            for (std::size_t i = 0; i < n; ++i) {
+                datos[i] = generar<T>(d, i, n, generador);
+            }
+            if (!referencia.contains(bytes)) {
+                referencia[bytes] = ancho_de_banda(datos.data(), bytes);
+            }
+            for (const auto& [nombre, ejecutar] : lista) {
+                double ns = medir_ns([&] { ejecutar(datos); });
+                Resultado r;
+                r.algoritmo = nombre;
+                r.tipo = Tipo<T>::nombre;
+                r.distribucion = nombre_distribucion(d);
+                r.elementos = n;
+                r.bytes = bytes;
+                r.ns_elemento = ns / n;
+                r.gbs = bytes / ns;
+                r.porcentaje = 100.0 * r.gbs / referencia[bytes];
+                std::cout << std::left << std::setw(18) << r.algoritmo << std::setw(10) << r.tipo
+                          << std::setw(13) << r.distribucion << std::right << std::setw(14) << r.bytes
+                          << std::setw(12) << std::fixed << std::setprecision(3) << r.ns_elemento
+                          << std::setw(10) << std::setprecision(2) << r.gbs
+                          << std::setw(9) << std::setprecision(1) << r.porcentaje;
+                if (contadores) {
+                    // Pasada aparte de unos 10 ms, para que abrir y cerrar los contadores no cuente en el tiempo
+                    std::size_t repeticiones = static_cast<std::size_t>(1e7 / ns) + 1;
+                    r.con_contadores = true;
+                    r.contadores = contadores->medir([&] { ejecutar(datos); }, repeticiones);
+                    for (double& cuenta : r.contadores) {
+                        cuenta /= static_cast<double>(n);
+                    }
+                    imprimir_contadores(r.contadores);
+                }
+                std::cout << "\n";
+                resultados.push_back(r);
+            }
+        }
+    }
+}
+
+// Bytes que la suite puede reservar: 3/4 de la memoria libre, para no llevar al sistema a swap
+std::size_t memoria_disponible() {
+#if CORE_NUMERIC_POSIX
+    long paginas = ::sysconf(_SC_AVPHYS_PAGES);
+    long pagina = ::sysconf(_SC_PAGESIZE);
+    if (paginas > 0 && pagina > 0) {
+        return static_cast<std::size_t>(paginas) / 4 * 3 * static_cast<std::size_t>(pagina);
+    }
+#endif
+    return std::numeric_limits<std::size_t>::max();
+}
+
+int suite(std::size_t max_bytes, const std::string& ruta_json, bool con_contadores) {
+    // Desde un bloque que cabe en L1 hasta 4 GB, pasando por L2, L3 y RAM
+    std::vector<std::size_t> tamaños;
+    const std::size_t limite = std::min(max_bytes, memoria_disponible());
+    for (std::size_t bytes : {std::size_t{16} << 10, std::size_t{256} << 10, std::size_t{4} << 20,
+                              std::size_t{64} << 20, std::size_t{1} << 30, std::size_t{4} << 30}) {
+        if (bytes <= limite) {
+            tamaños.push_back(bytes);
+        } else {
+            std::cout << "Se omite el tamaño de " << (bytes >> 10) << " KB (limite " << (limite >> 10) << " KB)\n";
+        }
+    }
+
+    // Sin permiso para ningun contador se avisa y se sigue solo con tiempos
+    std::unique_ptr<Contadores> contadores;
+    if (con_contadores) {
+        contadores = std::make_unique<Contadores>();
+        if (!contadores->alguno()) {
+            std::cout << "Contadores de hardware no disponibles (" << contadores->motivo() << "), solo tiempos\n";
+            contadores.reset();
+        } else if (!contadores->motivo().empty()) {
+            std::cout << "Algunos contadores no estan disponibles (" << contadores->motivo() << ")\n";
+        }
+    }
+
+    std::cout << "Suite con ISA " << core_numeric::isa_name(core_numeric::active_isa()) << "\n";
+    std::cout << std::left << std::setw(18) << "algoritmo" << std::setw(10) << "tipo" << std::setw(13) << "datos"
+              << std::right << std::setw(14) << "bytes" << std::setw(12) << "ns/elem" << std::setw(10) << "GB/s"
+              << std::setw(9) << "%BW";
+    if (contadores) {
+        std::cout << std::setw(10) << "ciclos/e" << std::setw(7) << "IPC" << std::setw(10) << "L1/ke"
+                  << std::setw(10) << "LLC/ke" << std::setw(10) << "salto/ke" << std::setw(9) << "%parado";
+    }
+    std::cout << "\n";
+
+    std::map<std::size_t, double> referencia;
+    std::vector<Resultado> resultados;
+    medir_tipo<std::int8_t>(tamaños, referencia, contadores.get(), resultados);
+    medir_tipo<std::int16_t>(tamaños, referencia, contadores.get(), resultados);
+    medir_tipo<std::int32_t>(tamaños, referencia, contadores.get(), resultados);
+    medir_tipo<std::int64_t>(tamaños, referencia, contadores.get(), resultados);
+    medir_tipo<float>(tamaños, referencia, contadores.get(), resultados);
+    medir_tipo<double>(tamaños, referencia, contadores.get(), resultados);
+    medir_tipo<Vector3D>(tamaños, referencia, contadores.get(), resultados);
+
+    // Funciones variadicas: sin contenedor, se mide el tiempo por llamada.
+    // Los argumentos se leen de volatile para que no se calculen en compilacion
+    volatile double a = 1.5, b = 2.5, c = 4.0, d = -3.0;
+    std::vector<std::pair<std::string, double>> variadicas = {
+        {"sum_variadic", medir_ns([&] { no_optimizar(core_numeric::sum_variadic(a, b, c, d)); })},
+        {"mean_variadic", medir_ns([&] { no_optimizar(core_numeric::mean_variadic(a, b, c, d)); })},
+        {"max_variadic", medir_ns([&] { no_optimizar(core_numeric::max_variadic(a, b, c, d)); })},
+        {"variance_variadic", medir_ns([&] { no_optimizar(core_numeric::variance_variadic(a, b, c, d)); })},
+    };
+    std::cout << "\n" << std::left << std::setw(20) << "variadica (4 double)" << std::right << std::setw(12) << "ns/llamada" << "\n";
+    for (const auto& [nombre, ns] : variadicas) {
+        std::cout << std::left << std::setw(20) << nombre << std::right << std::setw(12) << std::fixed
+                  << std::setprecision(2) << ns << "\n";
+    }
+
+    std::ostringstream json;
+    json << std::setprecision(6) << "{\n  \"isa\": \"" << core_numeric::isa_name(core_numeric::active_isa())
+         << "\",\n  \"hardware_threads\": " << std::thread::hardware_concurrency()
+         << ",\n  \"counters\": " << (contadores ? "true" : "false")
+         << ",\n  \"bandwidth_gbs\": {";
+    bool primero = true;
+    for (const auto& [bytes, gbs] : referencia) {
+        json << (primero ? "" : ",") << "\n    \"" << bytes << "\": " << gbs;
+        primero = false;
+    }
+    json << "\n  },\n  \"results\": [";
+    for (std::size_t i = 0; i < resultados.size(); ++i) {
+        const auto& r = resultados[i];
+        json << (i == 0 ? "" : ",") << "\n    {\"algorithm\": \"" << r.algoritmo << "\", \"type\": \"" << r.tipo
+             << "\", \"distribution\": \"" << r.distribucion << "\", \"elements\": " << r.elementos
+             << ", \"bytes\": " << r.bytes << ", \"ns_per_element\": " << r.ns_elemento
+             << ", \"gb_per_s\": " << r.gbs << ", \"percent_bandwidth\": " << r.porcentaje;
+        if (r.con_contadores) {
+            // Cuentas por elemento; null si el evento no esta disponible
+            json << ", \"counters_per_element\": {";
+            for (std::size_t e = 0; e < Contadores::total; ++e) {
+                json << (e == 0 ? "" : ", ") << "\"" << Contadores::nombres[e] << "\": ";
+                if (std::isnan(r.contadores[e])) {
+                    json << "null";
+                } else {
+                    json << r.contadores[e];
+                }
+            }
+            json << "}";
+        }
+        json << "}";
+    }
+    json << "\n  ],\n  \"variadic\": [";
+    for (std::size_t i = 0; i < variadicas.size(); ++i) {
+        json << (i == 0 ? "" : ",") << "\n    {\"function\": \"" << variadicas[i].first
+             << "\", \"arguments\": 4, \"ns_per_call\": " << variadicas[i].second << "}";
+    }
+    json << "\n  ]\n}\n";
+
+    std::ofstream archivo(ruta_json);
+    archivo << json.str();
+    if (!archivo) {
+        std::cerr << "No se pudo escribir " << ruta_json << "\n";
+        return 1;
+    }
+    std::cout << "\nResultados en " << ruta_json << "\n";
+    return 0;
+}
+
+// LATENCIA DEL POOL:
+
+// Suma repartida creando hilos en cada llamada, como hacian las politicas paralelas antes del pool
+double suma_con_hilos_nuevos(const std::vector<double>& datos, unsigned hilos) {
+    std::vector<double> parciales(hilos);
+    std::vector<std::thread> trabajadores;
+    const std::size_t n = datos.size();
+    for (unsigned k = 1; k < hilos; ++k) {
+        trabajadores.emplace_back([&, k] {
+            std::span<const double> trozo(datos.data() + n * k / hilos, n * (k + 1) / hilos - n * k / hilos);
+            parciales[k] = core_numeric::sum(trozo);
+        });
+    }
+    parciales[0] = core_numeric::sum(std::span<const double>(datos.data(), n / hilos));
+    for (auto& hilo : trabajadores) {
+        hilo.join();
+    }
+    return core_numeric::sum(parciales);
+}
+
+int latencia() {
+    // Tantos trozos como hilos tiene el pool, contando al que llama
+    auto& pool = core_numeric::detail::fork_join_pool::instance();
+    const unsigned hilos = pool.workers() + 1;
+    const auto politica = core_numeric::execution::par.with_threads(hilos);
+
+    std::cout << "Pool fork-join: " << pool.workers() << " trabajadores + el hilo que llama, ISA "
+              << core_numeric::isa_name(core_numeric::active_isa()) << "\n";
+    auto vacia = [](unsigned) {};
+    double ns_vacio = medir_ns([&] { pool.run(hilos, vacia); });
+    std::cout << "Fork-join vacio con " << hilos << " tareas: " << std::fixed << std::setprecision(2)
+              << ns_vacio / 1000.0 << " us\n\n";
+
+    std::cout << std::left << std::setw(10) << "algoritmo" << std::right << std::setw(10) << "elementos"
+              << std::setw(12) << "serie us" << std::setw(12) << "pool us" << std::setw(14) << "hilos new us"
+              << std::setw(10) << "speedup" << "\n";
+
+    Generador generador{42};
+    for (std::size_t n : {std::size_t{1} << 10, std::size_t{1} << 13, std::size_t{10000}, std::size_t{1} << 15,
+                          std::size_t{100000}, std::size_t{1} << 18, std::size_t{500000}, std::size_t{1} << 20}) {
+        std::vector<double> datos(n);
+        for (auto& valor : datos) {
+            valor = -1000.0 + 2000.0 * generador.uniforme();
+        }
+
+        struct Caso {
+            const char* nombre;
+            std::function<void()> serie;
+            std::function<void()> paralelo;
+            std::function<void()> hilos_nuevos;  // Solo para sum
+        };
+        std::vector<Caso> casos = {
+            {"sum", [&] { no_optimizar(core_numeric::sum(datos)); },
+             [&] { no_optimizar(core_numeric::sum(politica, datos)); },
+             [&] { no_optimizar(suma_con_hilos_nuevos(datos, hilos)); }},
+            {"variance", [&] { no_optimizar(core_numeric::variance(datos)); },
+             [&] { no_optimizar(core_numeric::variance(politica, datos)); }, nullptr},
+            {"max", [&] { no_optimizar(core_numeric::max(datos)); },
+             [&] { no_optimizar(core_numeric::max(politica, datos)); }, nullptr},
+        };
+        for (const auto& caso : casos) {
+            double serie = medir_ns(caso.serie);
+            double paralelo = medir_ns(caso.paralelo);
+            std::cout << std::left << std::setw(10) << caso.nombre << std::right << std::setw(10) << n
+                      << std::setw(12) << std::fixed << std::setprecision(2) << serie / 1000.0
+                      << std::setw(12) << paralelo / 1000.0;
+            if (caso.hilos_nuevos) {
+                std::cout << std::setw(14) << medir_ns(caso.hilos_nuevos) / 1000.0;
+            } else {
+                std::cout << std::setw(14) << "-";
+            }
+            std::cout << std::setw(10) << serie / paralelo << "\n";
+        }
+    }
+    return 0;
+}
+
+// ESCALABILIDAD:
+
+int escalabilidad(std::size_t n, const std::string& ruta) {
+    std::vector<double> datos(n);
+    std::mt19937_64 generador(42);
+    std::uniform_real_distribution<double> distribucion(-1000.0, 1000.0);
+    for (auto& valor : datos) {
+        valor = distribucion(generador);
+    }
+
+    std::cout << "Escalabilidad con " << n << " doubles (" << (n * sizeof(double)) / (1 << 20) << " MB), ISA "
+              << core_numeric::isa_name(core_numeric::active_isa()) << "\n";
+
+    struct Caso {
+        std::string nombre;
+        std::function<void(unsigned)> ejecutar;
+    };
+    auto cuadrado = [](double x) { return x * x; };
+    std::vector<Caso> casos = {
+        {"sum", [&](unsigned h) { no_optimizar(core_numeric::sum(core_numeric::execution::par.with_threads(h), datos)); }},
+        {"mean", [&](unsigned h) { no_optimizar(core_numeric::mean(core_numeric::execution::par.with_threads(h), datos)); }},
+        {"variance", [&](unsigned h) { no_optimizar(core_numeric::variance(core_numeric::execution::par.with_threads(h), datos)); }},
+        {"max", [&](unsigned h) { no_optimizar(core_numeric::max(core_numeric::execution::par.with_threads(h), datos)); }},
+        {"transform_reduce", [&](unsigned h) {
+            no_optimizar(core_numeric::transform_reduce(core_numeric::execution::par_unseq.with_threads(h), datos, cuadrado));
+        }},
+    };
+
+    auto hilos = hilos_a_probar();
+    std::cout << std::left << std::setw(18) << "algoritmo" << std::right << std::setw(8) << "hilos"
+              << std::setw(12) << "ms" << std::setw(10) << "speedup" << std::setw(10) << "GB/s" << "\n";
+
+    for (const auto& caso : casos) {
+        double base = 0;
+        for (unsigned h : hilos) {
+            double ms = medir_ms([&] { caso.ejecutar(h); });
+            if (h == 1) base = ms;
+            double gbs = (n * sizeof(double)) / (ms * 1e6);
+            std::cout << std::left << std::setw(18) << caso.nombre << std::right << std::setw(8) << h
+                      << std::setw(12) << std::fixed << std::setprecision(3) << ms
+                      << std::setw(10) << std::setprecision(2) << base / ms
+                      << std::setw(10) << gbs << "\n";
+        }
+    }
+
+    // Columna en disco: leer el archivo a un vector y sumar contra mapped_column, que suma sobre
+    // las paginas mapeadas sin copiarlas, y column_stream, que lee por bloques en un hilo de fondo.
+    // El archivo queda en la cache de paginas despues de escribirlo, asi que se mide el caso caliente;
+    // en frio todos quedan limitados por el disco
+#if CORE_NUMERIC_POSIX
+    {
+        std::ofstream archivo(ruta, std::ios::binary);
+        archivo.write(reinterpret_cast<const char*>(datos.data()), static_cast<std::streamsize>(n * sizeof(double)));
+    }
+
+    struct CasoColumna {
+        std::string nombre;
+        std::function<void()> ejecutar;
+    };
+    std::vector<CasoColumna> columna = {
+        {"read+vector", [&] {
+            std::ifstream archivo(ruta, std::ios::binary);
+            std::vector<double> leidos(n);
+            archivo.read(reinterpret_cast<char*>(leidos.data()), static_cast<std::streamsize>(n * sizeof(double)));
+            no_optimizar(core_numeric::sum(leidos));
+        }},
+        {"mapped_column", [&] {
+            core_numeric::mapped_column<double> mapeada(ruta);
+            no_optimizar(core_numeric::sum(mapeada));
+        }},
+        {"mapped_column par", [&] {
+            core_numeric::mapped_column<double> mapeada(ruta);
+            no_optimizar(core_numeric::sum(core_numeric::execution::par, mapeada));
+        }},
+        {"column_stream", [&] {
+            core_numeric::column_stream<double> flujo(ruta);
+            no_optimizar(flujo.sum());
+        }},
+    };
+
+    std::cout << "\nColumna en disco (" << ruta << "), sum incluyendo abrir el archivo\n";
+    std::cout << std::left << std::setw(18) << "entrada" << std::right << std::setw(12) << "ms" << std::setw(10) << "GB/s" << "\n";
+    for (const auto& caso : columna) {
+        double ms = medir_ms(caso.ejecutar);
+        std::cout << std::left << std::setw(18) << caso.nombre << std::right
+                  << std::setw(12) << std::fixed << std::setprecision(3) << ms
+                  << std::setw(10) << std::setprecision(2) << (n * sizeof(double)) / (ms * 1e6) << "\n";
+    }
+    std::remove(ruta.c_str());
+#else
+    (void)ruta;
+#endif
+
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    std::vector<std::string> argumentos(argv + 1, argv + argc);
+
+    if (!argumentos.empty() && argumentos[0] == "pool") {
+        return latencia();
+    }
+    if (!argumentos.empty() && argumentos[0] == "scaling") {
+        std::size_t n = argumentos.size() > 1 ? std::stoull(argumentos[1]) : (std::size_t{1} << 25);
+        std::string ruta = argumentos.size() > 2 ? argumentos[2] : "bench_columna.bin";
+        return escalabilidad(n, ruta);
+    }
+
+    std::size_t max_bytes = std::size_t{4} << 30;
+    std::string ruta_json = "bench_output.json";
+    bool con_contadores = false;
+    for (std::size_t i = 0; i < argumentos.size(); ++i) {
+        if (argumentos[i] == "--max-bytes" && i + 1 < argumentos.size()) {
+            max_bytes = std::stoull(argumentos[++i]);
+        } else if (argumentos[i] == "--json" && i + 1 < argumentos.size()) {
+            ruta_json = argumentos[++i];
+        } else if (argumentos[i] == "--counters") {
+            con_contadores = true;
+        } else if (argumentos[i] != "suite") {
+            std::cerr << "Argumento desconocido: " << argumentos[i] << "\n";
+            return 1;
+        }
+    }
+    return suite(max_bytes, ruta_json, con_contadores);
+}
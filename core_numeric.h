@@ -3,28 +3,115 @@
 
 #include <concepts>     //Para definir concepts Addable, Divisible, Iterable, Comparable
 #include <vector>
-#include <iterator>     //Para std::begin y std::end
+#include <array>        // Para variance_variadic sin memoria dinamica
+#include <iterator>     //Para los conceptos de iteradores
 #include <type_traits>  //Para std::is_integral_v , constexpr
 #include <cmath> // Para operaciones matematicas
+#include <cstddef>      // Para std::size_t
+#include <cstdint>      // Para std::int32_t, std::int64_t
+#include <ranges>       // Para los concepts de rangos y std::ranges::subrange
+#include <atomic>       // Para el ISA activo, compartido entre hilos
+#include <cstdlib>      // Para std::getenv
+#include <string_view>
+#include <thread>       // Para las politicas de ejecucion paralelas
+#include <exception>    // Para propagar excepciones de los hilos
+#include <span>         // Para accumulator::push de bloques
+#include <limits>       // Para std::numeric_limits en los kernels de enteros
+#include <tuple>        // Para las columnas de soa_vector
+#include <utility>      // Para std::index_sequence
+#include <initializer_list>
+#include <functional>   // Para std::invoke en las tuberias y std::plus, std::multiplies, ... en transform_reduce
+#include <string>       // Para la ruta de mapped_column
+#include <system_error> // Para los errores de open/mmap en mapped_column
+#include <bit>          // Para std::endian: las columnas en disco son little-endian
+#include <mutex>        // Para el anillo de buffers de column_stream y el registro de la instrumentacion
+#include <condition_variable>
+#include <memory>       // Para el anillo de column_stream
+#include <new>          // Para std::bad_alloc
+
+// Kernels SIMD en x86 con GCC/Clang: cada kernel se compila para su ISA con el atributo target,
+// asi el binario no necesita -march=native y el kernel se elige en tiempo de ejecucion con cpuid
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define CORE_NUMERIC_X86 1
+#include <immintrin.h>
+#include <cpuid.h>
+#define CORE_NUMERIC_TARGET_SSE42 __attribute__((target("sse4.2")))
+#define CORE_NUMERIC_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#define CORE_NUMERIC_TARGET_AVX512 __attribute__((target("avx512f,avx2,fma")))
+#else
+#define CORE_NUMERIC_X86 0
+#endif
+
+// Enteros de 128 bits (extension de GCC/Clang en plataformas de 64 bits) para acumular enteros de 64 bits
+#if defined(__SIZEOF_INT128__)
+#define CORE_NUMERIC_HAS_INT128 1
+#else
+#define CORE_NUMERIC_HAS_INT128 0
+#endif
+
+// Columnas mapeadas en memoria con mmap (mapped_column), solo en sistemas POSIX
+#if defined(__unix__) || defined(__APPLE__)
+#define CORE_NUMERIC_POSIX 1
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define CORE_NUMERIC_POSIX 0
+#endif
+
+// Afinidad de los hilos del pool de las politicas paralelas (cada trabajador fijo en un nucleo)
+#if defined(__linux__)
+#define CORE_NUMERIC_AFFINITY 1
+#include <sched.h>
+#include <pthread.h>
+#else
+#define CORE_NUMERIC_AFFINITY 0
+#endif
+
+// Instrumentacion opcional (llamadas, elementos, kernel y ciclos por algoritmo).
+// Se activa con -DCORE_NUMERIC_INSTRUMENT=1; apagada no deja codigo ni variables thread_local
+#if !defined(CORE_NUMERIC_INSTRUMENT)
+#define CORE_NUMERIC_INSTRUMENT 0
+#endif
+#if CORE_NUMERIC_INSTRUMENT
+#include <chrono>       // Reloj para los ciclos fuera de x86
+#endif
+
+// Los kernels portables se fuerzan inline para que hereden el ISA de la funcion que los llama
+#if defined(__GNUC__) || defined(__clang__)
+#define CORE_NUMERIC_INLINE inline __attribute__((always_inline))
+#else
+#define CORE_NUMERIC_INLINE inline
+#endif
 
 namespace core_numeric {
 
 
     //CONCEPTS:
 
-    // Definimos el concept Iterable, verifica que el tipo tenga begin() y end()
+    // Definimos el concept Iterable sobre los rangos de C++20: cualquier cosa que se pueda recorrer
+    // al menos una vez con begin()/end(). Acepta contenedores, arreglos de C, std::span y vistas
+    // (std::views::filter, transform, ...), que se reducen directamente sin copiarlas a un vector.
+    // El tipo de los elementos se toma de std::ranges::range_value_t, no hace falta un miembro value_type
     template <typename C>
-    concept Iterable = requires (C c) {
-        std::begin(c);
-        std::end(c);
-    };
+    concept Iterable = std::ranges::input_range<C>;
 
-    // Definimos el concept Addable(), verifica que dos objetos tipo T se puedan sumar y den como resultado un T
+    // Definimos el concept Addable(), verifica que dos objetos tipo T se puedan sumar y den como resultado un T.
+    // Los tipos aritmeticos siempre lo son: int8/int16 promocionan a int al sumarse, pero sum, mean,
+    // variance y dot acumulan en accumulation_t, asi que la promocion no cambia el resultado
     template <typename T>
-    concept Addable = requires (T a, T b) {
+    concept Addable = std::is_arithmetic_v<T> || requires (T a, T b) {
         { a + b } -> std::same_as<T>;
     };
 
+    // Multipliable: dos T se multiplican y dan un T (para dot). Igual que Addable para los aritmeticos
+    template <typename T>
+    concept Multipliable = std::is_arithmetic_v<T> || requires (T a, T b) {
+        { a * b } -> std::same_as<T>;
+    };
+
     // Definimos el concept Divisible, verifica que T se pueda dividir por un size_t(entero sin signo).
     template <typename T>
     concept Divisible = requires (T a, std::size_t n) {
@@ -38,162 +125,5059 @@ namespace core_numeric {
         { a > b } -> std::convertible_to<bool>;
     };
 
-    // ALGORITMOS GENERICOS:
+    // TIPOS DE ACUMULACION:
 
-    
+    namespace detail {
+#if CORE_NUMERIC_HAS_INT128
+        __extension__ typedef __int128 int128;
+        __extension__ typedef unsigned __int128 uint128;
 
-    // Función sum
-    // Funcion auxiliar implementada para ser reutilizada en mean y variance
-    template <Iterable C>       //Tiene que ser de tipo iterable
-    requires Addable<typename C::value_type>    //El tipo de dato contenido debe ser sumable
-    auto sum(const C& contenedor) {
-        using T = typename C::value_type;
-        T resultado{}; // Inicializa en 0 o constructor por defecto
+        // Suma de cuadrados de enteros, siempre sin signo y modulo 2^128
+        using square_sum_t = uint128;
+#else
+        using square_sum_t = std::uint64_t;
+#endif
+    } // namespace detail
 
-        for (const auto& valor : contenedor) {
-            resultado = resultado + valor;
+    // Tipo en el que sum acumula los valores de T. Los enteros se ensanchan para no desbordar:
+    // hasta 32 bits se suma en 64 bits y los de 64 bits en 128. Flotantes y tipos de usuario suman en su propio tipo.
+    // Es un punto de personalizacion: se puede especializar para tipos propios
+    template <typename T>
+    struct accumulation_type {
+        using type = T;
+    };
+
+    template <std::signed_integral T>
+    requires (sizeof(T) <= 4)
+    struct accumulation_type<T> {
+        using type = std::int64_t;
+    };
+
+    template <std::unsigned_integral T>
+    requires (sizeof(T) <= 4)
+    struct accumulation_type<T> {
+        using type = std::uint64_t;
+    };
+
+#if CORE_NUMERIC_HAS_INT128
+    template <std::signed_integral T>
+    requires (sizeof(T) == 8)
+    struct accumulation_type<T> {
+        using type = detail::int128;
+    };
+
+    template <std::unsigned_integral T>
+    requires (sizeof(T) == 8)
+    struct accumulation_type<T> {
+        using type = detail::uint128;
+    };
+#endif
+
+    template <typename T>
+    using accumulation_t = typename accumulation_type<T>::type;
+
+    // OPERACIONES DE REDUCCION:
+
+    // Maximo y minimo como objetos funcion, para usarlos de operacion en transform_reduce.
+    // Con empate o NaN en b devuelven a, igual que max
+    struct maximum {
+        template <typename T>
+        constexpr T operator()(const T& a, const T& b) const { return b > a ? b : a; }
+    };
+
+    struct minimum {
+        template <typename T>
+        constexpr T operator()(const T& a, const T& b) const { return a > b ? b : a; }
+    };
+
+    namespace detail {
+
+        // maximum y minimum saltan un NaN solo cuando llega como b. Las reducciones que empiezan cada carril
+        // o trozo con su primer elemento (en vez de con el inicial) no pueden dejar que ese NaN quede como a:
+        // se llevaria todos los valores siguientes. Un acumulador NaN cuenta como vacio y el siguiente valor
+        // lo reemplaza, asi el resultado es el mismo que reducir en orden desde el inicial
+        template <typename Op, typename A>
+        CORE_NUMERIC_INLINE constexpr bool empty_seed(const A& acumulado) {
+            if constexpr (std::floating_point<A> && (std::same_as<std::remove_cvref_t<Op>, maximum>
+                                                     || std::same_as<std::remove_cvref_t<Op>, minimum>)) {
+                return acumulado != acumulado;
+            } else {
+                return false;
+            }
+        }
+
+        // Un paso de una reduccion sembrada con un elemento: op(a, b), o b si a es una semilla vacia
+        template <typename A, typename Op>
+        CORE_NUMERIC_INLINE constexpr A fold_step(Op& op, const A& a, const A& b) {
+            if (empty_seed<Op>(a)) return b;
+            return static_cast<A>(op(a, b));
+        }
+
+    } // namespace detail
+
+    // Operaciones asociativas y conmutativas: transform_reduce puede reordenarlas en carriles SIMD
+    // y entre hilos. Es un punto de personalizacion: se puede especializar para operaciones propias.
+    // La suma y el producto de flotantes se reordenan igual que en sum (el redondeo puede cambiar)
+    template <typename Op>
+    struct is_reassociable : std::false_type {};
+
+    template <typename T>
+    struct is_reassociable<std::plus<T>> : std::true_type {};
+    template <typename T>
+    struct is_reassociable<std::multiplies<T>> : std::true_type {};
+    template <typename T>
+    struct is_reassociable<std::bit_or<T>> : std::true_type {};
+    template <typename T>
+    struct is_reassociable<std::bit_and<T>> : std::true_type {};
+    template <typename T>
+    struct is_reassociable<std::bit_xor<T>> : std::true_type {};
+    template <>
+    struct is_reassociable<maximum> : std::true_type {};
+    template <>
+    struct is_reassociable<minimum> : std::true_type {};
+
+    template <typename Op>
+    inline constexpr bool is_reassociable_v = is_reassociable<std::remove_cvref_t<Op>>::value;
+
+    namespace detail {
+
+        // Tipos con media: los Divisible y ademas todos los enteros, que dividen en su tipo de acumulacion
+        // (dividir un entero con signo por size_t lo convertiria a sin signo)
+        template <typename T>
+        concept Averageable = Divisible<T> || std::integral<T>;
+
+        // La varianza de enteros puede no entrar en T (la de int32 llega a 2^62), se devuelve en el tipo de acumulacion
+        template <typename T>
+        using variance_type = std::conditional_t<std::is_integral_v<T>, accumulation_t<T>, T>;
+
+        // Cuadrado exacto de un entero (calculado con el doble de bits) para la suma de cuadrados
+        template <std::integral T>
+        constexpr square_sum_t square_of(T valor) {
+#if CORE_NUMERIC_HAS_INT128
+            using P = std::conditional_t<(sizeof(T) <= 4), std::int64_t, accumulation_t<T>>;
+#else
+            using P = std::conditional_t<(sizeof(T) <= 4), std::int64_t, std::uint64_t>;
+#endif
+            P x = static_cast<P>(valor);
+            return static_cast<square_sum_t>(x * x);
+        }
+    } // namespace detail
+
+    // TIPOS DE RESULTADO CON POSICION:
+
+    // Valor junto con su posicion en el contenedor, lo devuelven argmax y argmin
+    template <typename T>
+    struct indexed_value {
+        T value{};
+        std::size_t index = 0;
+    };
+
+    // Resultado de minmax: el minimo y el maximo, cada uno con su posicion
+    template <typename T>
+    struct minmax_result {
+        indexed_value<T> min;
+        indexed_value<T> max;
+    };
+
+    // DESPACHO EN TIEMPO DE EJECUCION:
+
+    // Conjuntos de instrucciones para los que hay kernels, de menor a mayor
+    enum class isa {
+        scalar,     // Codigo portable, sin suposiciones sobre la CPU
+        sse42,      // SSE4.2 (registros de 128 bits)
+        avx2,       // AVX2 + FMA (registros de 256 bits)
+        avx512      // AVX-512F (registros de 512 bits)
+    };
+
+    // Nombre legible del ISA, el mismo que acepta la variable de entorno CORE_NUMERIC_ISA
+    inline const char* isa_name(isa nivel) {
+        switch (nivel) {
+            case isa::sse42: return "sse42";
+            case isa::avx2: return "avx2";
+            case isa::avx512: return "avx512";
+            default: return "scalar";
         }
-        return resultado;
     }
 
-    // Algoritmo mean (promedio)
-    // Reutiliza sum y requiere concept Divisible
-    template <Iterable C>
-    requires Divisible<typename C::value_type> && Addable<typename C::value_type>
-    auto mean(const C& contenedor) {
-        // Reutilizamos sum como pide el PDF
-        auto suma_total = sum(contenedor);
-        std::size_t n = std::size(contenedor);
-        
-        // Evitamos división por cero 
-        if (n == 0) return typename C::value_type{}; 
+    namespace detail {
+
+        // Consulta cpuid una sola vez. Ademas de los bits de la CPU hay que revisar con xgetbv
+        // que el sistema operativo guarde los registros YMM/ZMM en los cambios de contexto
+        inline isa cpuid_isa() {
+#if CORE_NUMERIC_X86
+            unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+            if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) return isa::scalar;
+
+            const bool sse42 = (ecx & (1u << 20)) != 0;
+            const bool osxsave = (ecx & (1u << 27)) != 0;
+            const bool avx = (ecx & (1u << 28)) != 0;
+            const bool fma = (ecx & (1u << 12)) != 0;
+            if (!sse42) return isa::scalar;
+            if (!osxsave || !avx || !fma) return isa::sse42;
+
+            unsigned xcr0_lo = 0, xcr0_hi = 0;
+            __asm__ volatile("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+            const bool os_ymm = (xcr0_lo & 0x06u) == 0x06u;        // XMM | YMM
+            const bool os_zmm = (xcr0_lo & 0xE6u) == 0xE6u;        // XMM | YMM | opmask | ZMM
+            if (!os_ymm) return isa::sse42;
+
+            if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) return isa::sse42;
+            const bool avx2 = (ebx & (1u << 5)) != 0;
+            const bool avx512f = (ebx & (1u << 16)) != 0;
+            if (!avx2) return isa::sse42;
+            if (!avx512f || !os_zmm) return isa::avx2;
+            return isa::avx512;
+#else
+            return isa::scalar;
+#endif
+        }
+
+        // Traduce el valor de CORE_NUMERIC_ISA, -1 si no esta definida o no se reconoce
+        inline int isa_from_env() {
+            const char* valor = std::getenv("CORE_NUMERIC_ISA");
+            if (valor == nullptr) return -1;
+            std::string_view nombre(valor);
+            for (isa nivel : {isa::scalar, isa::sse42, isa::avx2, isa::avx512}) {
+                if (nombre == isa_name(nivel)) return static_cast<int>(nivel);
+            }
+            return -1;
+        }
+
+        // ISA activo. -1 significa que todavia no se inicializo
+        inline std::atomic<int> isa_activo{-1};
+
+    } // namespace detail
 
-        // Retornamos la división definida en el concept
-        return suma_total / n;
+    // Mejor ISA soportado por la CPU y el sistema operativo (se detecta una sola vez)
+    inline isa detected_isa() {
+        static const isa detectado = detail::cpuid_isa();
+        return detectado;
     }
 
-    // Algoritmo variance (varianza)
-    // Reutiliza mean y utiliza concept Iterable, Addable y Divisible
-    template <Iterable C>
-    requires Addable<typename C::value_type> && Divisible<typename C::value_type>
-    auto variance(const C& contenedor) {
-        auto promedio = mean(contenedor);
-        using T = typename C::value_type;
-        
-        T acumulador{}; 
+    // Fija el kernel a usar, por ejemplo para comparar kernels en un benchmark.
+    // Nunca se sube por encima de lo que soporta la CPU, devuelve el ISA que quedo activo
+    inline isa set_isa(isa nivel) {
+        if (nivel > detected_isa()) nivel = detected_isa();
+        detail::isa_activo.store(static_cast<int>(nivel), std::memory_order_relaxed);
+        return nivel;
+    }
 
-        // Separamos la logica en tiempo de compilación
-        // Usamos if constexpr para distinguir entre tipos enteros y de punto flotante
+    // ISA que usan los algoritmos. La primera vez respeta la variable de entorno CORE_NUMERIC_ISA
+    inline isa active_isa() {
+        int actual = detail::isa_activo.load(std::memory_order_relaxed);
+        if (actual < 0) {
+            int pedido = detail::isa_from_env();
+            return set_isa(pedido < 0 ? detected_isa() : static_cast<isa>(pedido));
+        }
+        return static_cast<isa>(actual);
+    }
 
-        if constexpr (std::is_integral_v<T>) {
-            // Para los enteros, usamos multiplicacion directa por eficiencia y para evitar casting
 
-             for (const auto& valor : contenedor) {
-                auto diff = valor - promedio; 
-                acumulador = acumulador + (diff * diff);
+    // INSTRUMENTACION:
+
+    // Contadores por algoritmo para saber en produccion cuanto trabajo hace cada llamada.
+    // Cada hilo cuenta en sus propias variables thread_local (sin contencion); snapshot() junta todos los
+    // hilos vivos y los que ya terminaron. Con CORE_NUMERIC_INSTRUMENT=0 (por defecto) los puntos de
+    // medida son macros vacias y snapshot() devuelve ceros
+    namespace instrumentation {
+
+        inline constexpr bool enabled = CORE_NUMERIC_INSTRUMENT != 0;
+
+        // Algoritmos instrumentados
+        enum class algorithm {
+            sum, mean, variance, max, min, argmax, argmin, minmax, transform_reduce, dot, summarize, describe,
+            summarize_batch, describe_batch
+        };
+        inline constexpr std::size_t algorithm_count = 14;
+
+        inline const char* algorithm_name(algorithm a) {
+            constexpr const char* nombres[algorithm_count] = {
+                "sum", "mean", "variance", "max", "min", "argmax", "argmin", "minmax", "transform_reduce", "dot",
+                "summarize", "describe", "summarize_batch", "describe_batch",
+            };
+            return nombres[static_cast<std::size_t>(a)];
+        }
+
+        // Kernels posibles: uno por ISA (en el orden de isa) y el camino generico, el bucle de la plantilla
+        // que usan los tipos de usuario, los rangos no contiguos y la evaluacion constexpr
+        inline constexpr std::size_t kernel_count = 5;
+        inline constexpr std::size_t generic_kernel = kernel_count - 1;
+
+        inline const char* kernel_name(std::size_t kernel) {
+            return kernel < generic_kernel ? isa_name(static_cast<isa>(kernel)) : "generic";
+        }
+
+        struct algorithm_stats {
+            std::uint64_t calls = 0;
+            std::uint64_t elements = 0;        // Solo de rangos con tamaño conocido: contar los demas costaria otra pasada.
+                                               // En los lotes cuenta series, no valores
+            std::uint64_t cycles = 0;          // Ciclos del TSC en x86, nanosegundos en el resto
+            std::uint64_t kernel_calls[kernel_count] = {};
+        };
+
+        struct snapshot_t {
+            algorithm_stats algorithms[algorithm_count] = {};
+
+            const algorithm_stats& operator[](algorithm a) const { return algorithms[static_cast<std::size_t>(a)]; }
+        };
+
+    } // namespace instrumentation
+
+#if CORE_NUMERIC_INSTRUMENT
+    namespace detail {
+
+        // Contadores de un hilo. Solo los escribe su hilo, pero snapshot() los lee desde otro:
+        // por eso son atomicos, con load + store relajados en vez de fetch_add
+        struct contadores_hilo {
+            struct por_algoritmo {
+                std::atomic<std::uint64_t> llamadas{0};
+                std::atomic<std::uint64_t> elementos{0};
+                std::atomic<std::uint64_t> ciclos{0};
+                std::atomic<std::uint64_t> kernels[instrumentation::kernel_count] = {};
+            };
+            por_algoritmo algoritmos[instrumentation::algorithm_count];
+
+            contadores_hilo();
+            ~contadores_hilo();
+
+            void sumar_en(instrumentation::snapshot_t& destino) const {
+                for (std::size_t a = 0; a < instrumentation::algorithm_count; ++a) {
+                    const auto& origen = algoritmos[a];
+                    auto& total = destino.algorithms[a];
+                    total.calls += origen.llamadas.load(std::memory_order_relaxed);
+                    total.elements += origen.elementos.load(std::memory_order_relaxed);
+                    total.cycles += origen.ciclos.load(std::memory_order_relaxed);
+                    for (std::size_t k = 0; k < instrumentation::kernel_count; ++k) {
+                        total.kernel_calls[k] += origen.kernels[k].load(std::memory_order_relaxed);
+                    }
+                }
             }
-        } else {
 
-            // Para float utilizamos libreria de precision std::pow de <cmath>, 
-            for (const auto& valor : contenedor) {
-                auto diff = valor - promedio;
-                acumulador = acumulador + std::pow(diff, 2);
+            void poner_en_cero() {
+                for (auto& algoritmo : algoritmos) {
+                    algoritmo.llamadas.store(0, std::memory_order_relaxed);
+                    algoritmo.elementos.store(0, std::memory_order_relaxed);
+                    algoritmo.ciclos.store(0, std::memory_order_relaxed);
+                    for (auto& kernel : algoritmo.kernels) {
+                        kernel.store(0, std::memory_order_relaxed);
+                    }
+                }
             }
+        };
+
+        // Hilos vivos y totales de los que ya terminaron
+        struct registro_instrumentacion {
+            std::mutex cerrojo;
+            std::vector<contadores_hilo*> vivos;
+            instrumentation::snapshot_t terminados;
+        };
+
+        inline registro_instrumentacion& registro() {
+            static registro_instrumentacion unico;
+            return unico;
         }
 
-        std::size_t n = std::size(contenedor);
-        if (n == 0) return T{};
-        
-        return acumulador / n;
-    }
+        inline contadores_hilo::contadores_hilo() {
+            auto& r = registro();
+            std::lock_guard<std::mutex> bloqueo(r.cerrojo);
+            r.vivos.push_back(this);
+        }
 
-    // Algoritmo max
-    // Busca el maximo elemento
-    // Aqui usamos el concept que creamos "Comparable"
-    template <Iterable C>
-    requires Comparable<typename C::value_type>
-    auto max(const C& contenedor) {
-        using T = typename C::value_type;
-        
-        // Manejo de contenedor vacio
-        if (std::empty(contenedor)) {
-            return T{}; 
+        inline contadores_hilo::~contadores_hilo() {
+            auto& r = registro();
+            std::lock_guard<std::mutex> bloqueo(r.cerrojo);
+            sumar_en(r.terminados);
+            for (std::size_t i = 0; i < r.vivos.size(); ++i) {
+                if (r.vivos[i] == this) {
+                    r.vivos[i] = r.vivos.back();
+                    r.vivos.pop_back();
+                    break;
+                }
+            }
         }
 
-        // Itera desde el segundo elemento
-        auto it = std::begin(contenedor);
-        T maximo = *it;
-        ++it;
+        inline contadores_hilo& contadores_del_hilo() {
+            thread_local contadores_hilo contadores;
+            return contadores;
+        }
 
-        for (; it != std::end(contenedor); ++it) {
-            if (*it > maximo) {
-                maximo = *it;
+        // Llamadas instrumentadas abiertas en este hilo: solo cuenta la exterior, asi mean no cuenta
+        // ademas un sum, ni cada trozo de una politica paralela cuenta como otra llamada
+        inline thread_local int profundidad_instrumentacion = 0;
+        // Kernel elegido por la llamada abierta, generic_kernel si no paso por ningun despacho
+        inline thread_local std::size_t kernel_instrumentado = instrumentation::generic_kernel;
+
+        inline std::uint64_t leer_ciclos() {
+#if CORE_NUMERIC_X86
+            return __rdtsc();
+#else
+            return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+        }
+
+        // Elementos de un rango si se conocen sin recorrerlo, 0 si no
+        template <typename C>
+        constexpr std::uint64_t instrument_size(const C& contenedor) {
+            if constexpr (std::ranges::sized_range<const C>) {
+                return static_cast<std::uint64_t>(std::ranges::size(contenedor));
+            } else {
+                return 0;
             }
         }
-        return maximo;
-    }
 
-    // Algoritmo transform_reduce
-    // Recibe una función para transformar cada elemento antes de sumar.
-    // Lo utilizaremos en el test.cpp para sumar cuadrados.
-    template <Iterable C, typename Func>
-    requires Addable<typename C::value_type>
-    auto transform_reduce(const C& contenedor, Func funcion) {
-        using T = typename C::value_type;
-        T resultado{};
+        // Mide una llamada desde su construccion hasta su destruccion. Es un tipo literal para poder
+        // declararlo en funciones constexpr: en evaluacion constante no hace nada
+        class instrument_scope {
+        public:
+            constexpr instrument_scope(instrumentation::algorithm algoritmo, std::uint64_t elementos)
+                : algoritmo_(algoritmo) {
+                if (!std::is_constant_evaluated()) abrir(elementos);
+            }
 
-        for (const auto& valor : contenedor) {
-            resultado = resultado + funcion(valor);
+            constexpr ~instrument_scope() {
+                if (!std::is_constant_evaluated()) cerrar();
+            }
+
+            instrument_scope(const instrument_scope&) = delete;
+            instrument_scope& operator=(const instrument_scope&) = delete;
+
+        private:
+            void abrir(std::uint64_t elementos) {
+                exterior_ = profundidad_instrumentacion++ == 0;
+                if (!exterior_) return;
+                elementos_ = elementos;
+                kernel_instrumentado = instrumentation::generic_kernel;
+                inicio_ = leer_ciclos();
+            }
+
+            void cerrar() {
+                --profundidad_instrumentacion;
+                if (!exterior_) return;
+                std::uint64_t ciclos = leer_ciclos() - inicio_;
+                auto& contadores = contadores_del_hilo().algoritmos[static_cast<std::size_t>(algoritmo_)];
+                auto sumar = [](std::atomic<std::uint64_t>& contador, std::uint64_t valor) {
+                    contador.store(contador.load(std::memory_order_relaxed) + valor, std::memory_order_relaxed);
+                };
+                sumar(contadores.llamadas, 1);
+                sumar(contadores.elementos, elementos_);
+                sumar(contadores.ciclos, ciclos);
+                sumar(contadores.kernels[kernel_instrumentado], 1);
+            }
+
+            instrumentation::algorithm algoritmo_;
+            bool exterior_ = false;
+            std::uint64_t elementos_ = 0;
+            std::uint64_t inicio_ = 0;
+        };
+
+        // Marca los hilos de trabajo de las politicas paralelas como dentro de la llamada que los creo
+        struct instrument_worker {
+            instrument_worker() { ++profundidad_instrumentacion; }
+            ~instrument_worker() { --profundidad_instrumentacion; }
+        };
+
+    } // namespace detail
+
+#define CORE_NUMERIC_INSTRUMENT_SCOPE(algoritmo, contenedor)                                               \
+    ::core_numeric::detail::instrument_scope instrumentacion_(                                             \
+        ::core_numeric::instrumentation::algorithm::algoritmo, ::core_numeric::detail::instrument_size(contenedor))
+#define CORE_NUMERIC_INSTRUMENT_WORKER() ::core_numeric::detail::instrument_worker instrumentacion_hilo_
+#define CORE_NUMERIC_INSTRUMENT_KERNEL(nivel) \
+    (::core_numeric::detail::kernel_instrumentado = static_cast<std::size_t>(nivel))
+#else
+#define CORE_NUMERIC_INSTRUMENT_SCOPE(algoritmo, contenedor) static_cast<void>(0)
+#define CORE_NUMERIC_INSTRUMENT_WORKER() static_cast<void>(0)
+#define CORE_NUMERIC_INSTRUMENT_KERNEL(nivel) static_cast<void>(0)
+#endif
+
+    namespace instrumentation {
+
+        // Totales de todos los hilos, incluidos los que ya terminaron
+        inline snapshot_t snapshot() {
+            snapshot_t resultado;
+#if CORE_NUMERIC_INSTRUMENT
+            auto& r = detail::registro();
+            std::lock_guard<std::mutex> bloqueo(r.cerrojo);
+            resultado = r.terminados;
+            for (const auto* contadores : r.vivos) {
+                contadores->sumar_en(resultado);
+            }
+#endif
+            return resultado;
         }
-        return resultado;
-    }
 
+        // Solo los contadores del hilo que llama
+        inline snapshot_t thread_snapshot() {
+            snapshot_t resultado;
+#if CORE_NUMERIC_INSTRUMENT
+            detail::contadores_del_hilo().sumar_en(resultado);
+#endif
+            return resultado;
+        }
 
-    // sum_variadic
-    //Suma todos los argumentos del pack usando fold expression binaria derecha (...)
-    template <typename... Args>
-    requires (Addable<Args> && ...) // Todos los argumentos deben ser Addable
-    auto sum_variadic(Args... args) {
-        return (... + args);
-    }
+        // Pone en cero los contadores de todos los hilos. Una llamada que termina en otro hilo mientras
+        // tanto puede perderse o quedar contada: pensado para usar entre fases, no en medio de ellas
+        inline void reset() {
+#if CORE_NUMERIC_INSTRUMENT
+            auto& r = detail::registro();
+            std::lock_guard<std::mutex> bloqueo(r.cerrojo);
+            r.terminados = snapshot_t{};
+            for (auto* contadores : r.vivos) {
+                contadores->poner_en_cero();
+            }
+#endif
+        }
 
-    // mean_variadic
-    // Calcula el promedio aprovechando la función sum_variadic y sizeof... para contar argumentos.
-    template <typename... Args>
-    auto mean_variadic(Args... args) {
-        auto suma = sum_variadic(args...);
-        return suma / sizeof...(args);
-    }
+    } // namespace instrumentation
 
+    namespace detail {
 
-    // variance_variadic:
+        // ISA para los puntos de despacho de los kernels: active_isa() y, si la instrumentacion
+        // esta activa, anota el kernel en la llamada abierta
+        inline isa kernel_isa() {
+            isa nivel = active_isa();
+            CORE_NUMERIC_INSTRUMENT_KERNEL(nivel);
+            return nivel;
+        }
 
-    // Para calcular la varianza se necesita recorrer los datos dos veces (una para el promedio, otra para diferencias)
-    // Como no se puede iterar un parameter pack dos veces facil, se mueven los datos 
-    // a un vector temporal y se reutiliza la función variance generica
-    template <typename T, typename... Args>
-    auto variance_variadic(T first, Args... args) {
-        std::vector<T> temp_vec{first, args...};
-        return variance(temp_vec);
-    }
+    } // namespace detail
 
-    // max_variadic
-    // Maximo de N argumentos usando fold expressions
 
-    // Usamos una funcion auxiliar para comparar
-    template <typename T>
-    T max_aux(T a, T b) {
-        return (a > b) ? a : b;
-    }
+    // KERNELS SIMD:
 
-    template <typename T, typename... Args>
-    requires (Comparable<T> && ... && Comparable<Args>)
-    T max_variadic(T first, Args... rest) {
-        T max_val = first;
-        // Fold expression con operador coma para actualizar max_val
-        ((max_val = max_aux(max_val, rest)), ...);
-        return max_val;
-    }
+    // Los detalles de implementacion van en el namespace detail, no son parte de la interfaz
+    namespace detail {
+
+        // Tipos nativos que tienen kernel vectorizado
+        template <typename T>
+        concept SimdSummable = std::same_as<T, float> || std::same_as<T, double>
+                            || std::same_as<T, std::int32_t> || std::same_as<T, std::int64_t>;
+
+        // Rango contiguo en memoria (vector, array, arreglo de C, span, ...) cuyos elementos tienen kernel.
+        // Solo en ese caso podemos leer directamente desde std::ranges::data
+        template <typename C>
+        concept SimdRange = std::ranges::contiguous_range<C>
+                         && std::ranges::sized_range<C>
+                         && SimdSummable<std::ranges::range_value_t<C>>;
+
+        // Rango contiguo de cualquier tipo aritmetico, para transform_reduce
+        template <typename C>
+        concept ArithmeticRange = std::ranges::contiguous_range<C>
+                               && std::ranges::sized_range<C>
+                               && std::is_arithmetic_v<std::ranges::range_value_t<C>>;
+
+        // Numero de elementos: directo si el rango conoce su tamaño; si no (por ejemplo una vista filtrada)
+        // se cuentan recorriendolo, lo que requiere un rango de varias pasadas
+        template <typename C>
+        constexpr std::size_t count_of(C&& contenedor) {
+            if constexpr (std::ranges::sized_range<C>) {
+                return static_cast<std::size_t>(std::ranges::size(contenedor));
+            } else {
+                return static_cast<std::size_t>(std::ranges::distance(contenedor));
+            }
+        }
+
+        // Version portable, sin intrinsics. Es el kernel del nivel scalar y, compilada con
+        // target("sse4.2"), tambien el del nivel sse42 (el compilador la vectoriza a 128 bits).
+        // Usa 8 acumuladores independientes para romper la cadena de dependencias,
+        // asi el compilador puede vectorizarla sin reordenar operaciones.
+        namespace portable {
+
+            // Tipo en el que se acumula: unsigned para enteros (desborde modular y no UB, igual que en SIMD),
+            // el mismo tipo para flotantes
+            template <typename T>
+            struct wrap_type { using type = T; };
+
+            template <typename T>
+            requires std::is_integral_v<T>
+            struct wrap_type<T> { using type = std::make_unsigned_t<T>; };
+
+            template <typename T>
+            CORE_NUMERIC_INLINE T sum(const T* datos, std::size_t n) {
+                using U = typename wrap_type<T>::type;
+                U acc[8] = {};
+                std::size_t i = 0;
+                for (; i + 8 <= n; i += 8) {
+                    for (std::size_t j = 0; j < 8; ++j) {
+                        acc[j] = acc[j] + static_cast<U>(datos[i + j]);
+                    }
+                }
+                for (; i < n; ++i) {
+                    acc[0] = acc[0] + static_cast<U>(datos[i]);
+                }
+                U resultado = ((acc[0] + acc[1]) + (acc[2] + acc[3])) + ((acc[4] + acc[5]) + (acc[6] + acc[7]));
+                return static_cast<T>(resultado);
+            }
+
+            // Maximo de n >= 1 elementos. Conserva la semantica del bucle escalar de max:
+            // un NaN en la primera posicion se propaga, los demas se ignoran (x > NaN es falso)
+            template <typename T>
+            CORE_NUMERIC_INLINE T max(const T* datos, std::size_t n) {
+                T acc[8];
+                for (std::size_t j = 0; j < 8; ++j) {
+                    acc[j] = datos[0];
+                }
+                std::size_t i = 0;
+                for (; i + 8 <= n; i += 8) {
+                    for (std::size_t j = 0; j < 8; ++j) {
+                        acc[j] = datos[i + j] > acc[j] ? datos[i + j] : acc[j];
+                    }
+                }
+                for (; i < n; ++i) {
+                    acc[0] = datos[i] > acc[0] ? datos[i] : acc[0];
+                }
+                T maximo = acc[0];
+                for (std::size_t j = 1; j < 8; ++j) {
+                    if (acc[j] > maximo) maximo = acc[j];
+                }
+                return maximo;
+            }
+
+            // Minimo de n >= 1 elementos, con la misma semantica de NaN que max
+            template <typename T>
+            CORE_NUMERIC_INLINE T min(const T* datos, std::size_t n) {
+                T acc[8];
+                for (std::size_t j = 0; j < 8; ++j) {
+                    acc[j] = datos[0];
+                }
+                std::size_t i = 0;
+                for (; i + 8 <= n; i += 8) {
+                    for (std::size_t j = 0; j < 8; ++j) {
+                        acc[j] = acc[j] > datos[i + j] ? datos[i + j] : acc[j];
+                    }
+                }
+                for (; i < n; ++i) {
+                    acc[0] = acc[0] > datos[i] ? datos[i] : acc[0];
+                }
+                T minimo = acc[0];
+                for (std::size_t j = 1; j < 8; ++j) {
+                    if (minimo > acc[j]) minimo = acc[j];
+                }
+                return minimo;
+            }
+
+            // Suma de cuadrados de las desviaciones respecto a 'media', para variance en flotantes
+            template <typename T>
+            CORE_NUMERIC_INLINE T sum_sq_dev(const T* datos, std::size_t n, T media) {
+                T acc[8] = {};
+                std::size_t i = 0;
+                for (; i + 8 <= n; i += 8) {
+                    for (std::size_t j = 0; j < 8; ++j) {
+                        T diff = datos[i + j] - media;
+                        acc[j] = acc[j] + diff * diff;
+                    }
+                }
+                for (; i < n; ++i) {
+                    T diff = datos[i] - media;
+                    acc[0] = acc[0] + diff * diff;
+                }
+                return ((acc[0] + acc[1]) + (acc[2] + acc[3])) + ((acc[4] + acc[5]) + (acc[6] + acc[7]));
+            }
+
+            // Reduccion con op de los valores leer(i), i en [0, n), acumulando en A, con la misma estructura de
+            // 8 acumuladores. Cada acumulador empieza con su primer elemento, asi no hace falta el neutro de op;
+            // el inicial se combina al final. Los acumuladores avanzan con fold_step (un NaN de semilla no se
+            // lleva el carril de maximum/minimum). La lectura, la funcion y la operacion se inlinean dentro de cada
+            // version compilada por ISA
+            template <typename A, typename Op, typename Leer>
+            CORE_NUMERIC_INLINE A fold_indexed(std::size_t n, A inicial, Op& op, Leer leer) {
+                std::size_t i = 0;
+                if (n >= 8) {
+                    A acc[8];
+                    for (std::size_t j = 0; j < 8; ++j) {
+                        acc[j] = leer(j);
+                    }
+                    for (i = 8; i + 8 <= n; i += 8) {
+                        for (std::size_t j = 0; j < 8; ++j) {
+                            acc[j] = fold_step(op, acc[j], static_cast<A>(leer(i + j)));
+                        }
+                    }
+                    for (std::size_t paso = 4; paso > 0; paso /= 2) {
+                        for (std::size_t j = 0; j < paso; ++j) {
+                            acc[j] = fold_step(op, acc[j], acc[j + paso]);
+                        }
+                    }
+                    inicial = static_cast<A>(op(inicial, acc[0]));
+                }
+                for (; i < n; ++i) {
+                    inicial = static_cast<A>(op(inicial, leer(i)));
+                }
+                return inicial;
+            }
+
+            // Lectores para fold_indexed: funcion(datos[i]) y funcion(a[i], b[i]) convertidos a A.
+            // Son structs y no lambdas porque las lambdas no heredan el target del kernel que las llama
+            template <typename A, typename T, typename Func>
+            struct transformed {
+                const T* datos;
+                Func& funcion;
+                CORE_NUMERIC_INLINE A operator()(std::size_t i) const { return static_cast<A>(funcion(datos[i])); }
+            };
+
+            template <typename A, typename T, typename U, typename Func>
+            struct transformed_pair {
+                const T* a;
+                const U* b;
+                Func& funcion;
+                CORE_NUMERIC_INLINE A operator()(std::size_t i) const { return static_cast<A>(funcion(a[i], b[i])); }
+            };
+
+            template <typename T, typename A, typename Op, typename Func>
+            CORE_NUMERIC_INLINE A transform_fold(const T* datos, std::size_t n, A inicial, Op& op, Func& funcion) {
+                return fold_indexed(n, inicial, op, transformed<A, T, Func>{datos, funcion});
+            }
+
+            template <typename T, typename U, typename A, typename Op, typename Func>
+            CORE_NUMERIC_INLINE A transform_fold(const T* a, const U* b, std::size_t n, A inicial, Op& op, Func& funcion) {
+                return fold_indexed(n, inicial, op, transformed_pair<A, T, U, Func>{a, b, funcion});
+            }
+
+            // Producto escalar con 8 acumuladores independientes
+            template <typename T>
+            CORE_NUMERIC_INLINE T dot(const T* a, const T* b, std::size_t n) {
+                T acc[8] = {};
+                std::size_t i = 0;
+                for (; i + 8 <= n; i += 8) {
+                    for (std::size_t j = 0; j < 8; ++j) {
+                        acc[j] = acc[j] + a[i + j] * b[i + j];
+                    }
+                }
+                for (; i < n; ++i) {
+                    acc[0] = acc[0] + a[i] * b[i];
+                }
+                return ((acc[0] + acc[1]) + (acc[2] + acc[3])) + ((acc[4] + acc[5]) + (acc[6] + acc[7]));
+            }
+
+            // Suma compensada de Kahan-Babuska-Neumaier sobre los carriles de un kernel vectorial:
+            // suma las sumas parciales 's' de cada carril, despues los errores 'c' y por ultimo
+            // los 'm' elementos de la cola, siempre llevando el error de cada suma aparte
+            template <std::floating_point T>
+            CORE_NUMERIC_INLINE T kbn_finish(const T* s, const T* c, std::size_t carriles, const T* resto, std::size_t m) {
+                T suma{};
+                T compensacion{};
+                auto agregar = [&](T x) {
+                    T t = suma + x;
+                    if (std::abs(suma) >= std::abs(x)) {
+                        compensacion += (suma - t) + x;
+                    } else {
+                        compensacion += (x - t) + suma;
+                    }
+                    suma = t;
+                };
+                for (std::size_t j = 0; j < carriles; ++j) {
+                    agregar(s[j]);
+                }
+                for (std::size_t j = 0; j < carriles; ++j) {
+                    compensacion += c[j];
+                }
+                for (std::size_t k = 0; k < m; ++k) {
+                    agregar(resto[k]);
+                }
+                return suma + compensacion;
+            }
+
+            // Suma compensada en 8 carriles. Cada carril usa TwoSum de Knuth en vez de la comparacion
+            // de magnitudes de Neumaier: da el mismo error exacto de cada suma sin ramas, asi se vectoriza.
+            // Depende de la aritmetica IEEE estricta: con -ffast-math el compilador elimina la compensacion
+            template <std::floating_point T>
+            CORE_NUMERIC_INLINE T kbn_sum(const T* datos, std::size_t n) {
+                T s[8] = {};
+                T c[8] = {};
+                std::size_t i = 0;
+                for (; i + 8 <= n; i += 8) {
+                    for (std::size_t j = 0; j < 8; ++j) {
+                        T x = datos[i + j];
+                        T t = s[j] + x;
+                        T z = t - s[j];
+                        c[j] += (s[j] - (t - z)) + (x - z);
+                        s[j] = t;
+                    }
+                }
+                return kbn_finish(s, c, 8, datos + i, n - i);
+            }
+
+            // Suma ensanchada: cada valor se convierte al tipo de acumulacion antes de sumar
+            template <typename T>
+            CORE_NUMERIC_INLINE accumulation_t<T> wide_sum(const T* datos, std::size_t n) {
+                using A = accumulation_t<T>;
+                A acc[8] = {};
+                std::size_t i = 0;
+                for (; i + 8 <= n; i += 8) {
+                    for (std::size_t j = 0; j < 8; ++j) {
+                        acc[j] += static_cast<A>(datos[i + j]);
+                    }
+                }
+                for (; i < n; ++i) {
+                    acc[0] += static_cast<A>(datos[i]);
+                }
+                return ((acc[0] + acc[1]) + (acc[2] + acc[3])) + ((acc[4] + acc[5]) + (acc[6] + acc[7]));
+            }
+
+            // Suma de cuadrados de enteros modulo 2^128 (o 2^64 sin enteros de 128 bits).
+            // Cada cuadrado es exacto antes de acumular (square_of usa el doble de bits)
+            template <typename T>
+            CORE_NUMERIC_INLINE square_sum_t sum_squares(const T* datos, std::size_t n) {
+                square_sum_t acc[4] = {};
+                std::size_t i = 0;
+                for (; i + 4 <= n; i += 4) {
+                    for (std::size_t j = 0; j < 4; ++j) {
+                        acc[j] += square_of(datos[i + j]);
+                    }
+                }
+                for (; i < n; ++i) {
+                    acc[0] += square_of(datos[i]);
+                }
+                return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+            }
+
+            // Une los carriles de un kernel de extremos: gana el mejor valor y, si empatan,
+            // la posicion menor (la primera aparicion). Con Min se busca el menor, si no el mayor
+            template <bool Min, typename T, typename P>
+            CORE_NUMERIC_INLINE indexed_value<T> best_lane(const T* valores, const P* posiciones, std::size_t carriles) {
+                indexed_value<T> mejor{valores[0], static_cast<std::size_t>(posiciones[0])};
+                for (std::size_t j = 1; j < carriles; ++j) {
+                    bool gana = Min ? mejor.value > valores[j] : valores[j] > mejor.value;
+                    if (gana || (valores[j] == mejor.value && static_cast<std::size_t>(posiciones[j]) < mejor.index)) {
+                        mejor = {valores[j], static_cast<std::size_t>(posiciones[j])};
+                    }
+                }
+                return mejor;
+            }
+
+            // Cola escalar de los kernels de extremos: sus posiciones son mayores que las de los carriles,
+            // asi que basta la comparacion estricta para quedarse con la primera aparicion
+            template <bool Min, bool Max, typename T>
+            CORE_NUMERIC_INLINE void extremes_tail(minmax_result<T>& resultado, const T* datos, std::size_t i, std::size_t n) {
+                for (; i < n; ++i) {
+                    if constexpr (Max) {
+                        if (datos[i] > resultado.max.value) resultado.max = {datos[i], i};
+                    }
+                    if constexpr (Min) {
+                        if (resultado.min.value > datos[i]) resultado.min = {datos[i], i};
+                    }
+                }
+            }
+
+            // Minimo (Min) y/o maximo (Max) de n >= 1 elementos con su posicion, en una pasada.
+            // Cada carril guarda su mejor valor y la posicion donde lo encontro. Misma semantica de NaN que max:
+            // solo un NaN en la primera posicion se propaga (con posicion 0); los empates devuelven la primera aparicion
+            template <bool Min, bool Max, typename T>
+            CORE_NUMERIC_INLINE minmax_result<T> extremes(const T* datos, std::size_t n) {
+                T mayor[8], menor[8];
+                std::size_t pos_mayor[8] = {}, pos_menor[8] = {};
+                for (std::size_t j = 0; j < 8; ++j) {
+                    mayor[j] = datos[0];
+                    menor[j] = datos[0];
+                }
+                std::size_t i = 0;
+                for (; i + 8 <= n; i += 8) {
+                    for (std::size_t j = 0; j < 8; ++j) {
+                        T x = datos[i + j];
+                        if constexpr (Max) {
+                            bool cambia = x > mayor[j];
+                            mayor[j] = cambia ? x : mayor[j];
+                            pos_mayor[j] = cambia ? i + j : pos_mayor[j];
+                        }
+                        if constexpr (Min) {
+                            bool cambia = menor[j] > x;
+                            menor[j] = cambia ? x : menor[j];
+                            pos_menor[j] = cambia ? i + j : pos_menor[j];
+                        }
+                    }
+                }
+                minmax_result<T> resultado;
+                if constexpr (Max) resultado.max = best_lane<false>(mayor, pos_mayor, 8);
+                if constexpr (Min) resultado.min = best_lane<true>(menor, pos_menor, 8);
+                extremes_tail<Min, Max>(resultado, datos, i, n);
+                return resultado;
+            }
+
+#if CORE_NUMERIC_HAS_INT128
+            // Junta los carriles de un acumulador de 128 bits repartido en dos registros: parte baja y alta
+            CORE_NUMERIC_INLINE uint128 join_wide(const std::uint64_t* bajo, const std::uint64_t* alto, std::size_t carriles) {
+                uint128 resultado = 0;
+                for (std::size_t j = 0; j < carriles; ++j) {
+                    resultado += (static_cast<uint128>(alto[j]) << 64) | bajo[j];
+                }
+                return resultado;
+            }
+#endif
+        } // namespace portable
+
+#if CORE_NUMERIC_X86
+        // Nivel SSE4.2: los kernels portables recompilados para 128 bits
+        namespace sse42 {
+
+            template <typename T>
+            CORE_NUMERIC_TARGET_SSE42 T sum(const T* datos, std::size_t n) {
+                return portable::sum(datos, n);
+            }
+
+            template <typename T>
+            CORE_NUMERIC_TARGET_SSE42 T max(const T* datos, std::size_t n) {
+                return portable::max(datos, n);
+            }
+
+            template <typename T>
+            CORE_NUMERIC_TARGET_SSE42 T min(const T* datos, std::size_t n) {
+                return portable::min(datos, n);
+            }
+
+            template <bool Min, bool Max, typename T>
+            CORE_NUMERIC_TARGET_SSE42 minmax_result<T> extremes(const T* datos, std::size_t n) {
+                return portable::extremes<Min, Max>(datos, n);
+            }
+
+            template <typename T>
+            CORE_NUMERIC_TARGET_SSE42 T sum_sq_dev(const T* datos, std::size_t n, T media) {
+                return portable::sum_sq_dev(datos, n, media);
+            }
+
+            template <typename T, typename A, typename Op, typename Func>
+            CORE_NUMERIC_TARGET_SSE42 A transform_fold(const T* datos, std::size_t n, A inicial, Op& op, Func& funcion) {
+                return portable::transform_fold(datos, n, inicial, op, funcion);
+            }
+
+            template <typename T, typename U, typename A, typename Op, typename Func>
+            CORE_NUMERIC_TARGET_SSE42 A transform_fold(const T* a, const U* b, std::size_t n, A inicial, Op& op, Func& funcion) {
+                return portable::transform_fold(a, b, n, inicial, op, funcion);
+            }
+
+            template <typename T>
+            CORE_NUMERIC_TARGET_SSE42 T dot(const T* a, const T* b, std::size_t n) {
+                return portable::dot(a, b, n);
+            }
+
+            template <typename T>
+            CORE_NUMERIC_TARGET_SSE42 T kbn_sum(const T* datos, std::size_t n) {
+                return portable::kbn_sum(datos, n);
+            }
+
+            template <typename T>
+            CORE_NUMERIC_TARGET_SSE42 accumulation_t<T> wide_sum(const T* datos, std::size_t n) {
+                return portable::wide_sum(datos, n);
+            }
+
+            template <typename T>
+            CORE_NUMERIC_TARGET_SSE42 square_sum_t sum_squares(const T* datos, std::size_t n) {
+                return portable::sum_squares(datos, n);
+            }
+        } // namespace sse42
+
+        // Kernels AVX2 (registros de 256 bits), 4 acumuladores vectoriales por tipo
+        namespace avx2 {
+
+            CORE_NUMERIC_TARGET_AVX2 inline __m256i load(const std::int32_t* p) {
+                return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+            }
+
+            CORE_NUMERIC_TARGET_AVX2 inline __m256i load(const std::int64_t* p) {
+                return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+            }
+
+            // Reducciones horizontales: suman los carriles de un registro
+            CORE_NUMERIC_TARGET_AVX2 inline double hsum(__m256d v) {
+                __m128d s = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+                s = _mm_add_sd(s, _mm_unpackhi_pd(s, s));
+                return _mm_cvtsd_f64(s);
+            }
+
+            CORE_NUMERIC_TARGET_AVX2 inline float hsum(__m256 v) {
+                __m128 s = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+                s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+                s = _mm_add_ss(s, _mm_movehdup_ps(s));
+                return _mm_cvtss_f32(s);
+            }
+
+            CORE_NUMERIC_TARGET_AVX2 inline std::int32_t hsum_epi32(__m256i v) {
+                __m128i s = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+                s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(1, 0, 3, 2)));
+                s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(2, 3, 0, 1)));
+                return _mm_cvtsi128_si32(s);
+            }
+
+            CORE_NUMERIC_TARGET_AVX2 inline std::int64_t hsum_epi64(__m256i v) {
+                __m128i s = _mm_add_epi64(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+                s = _mm_add_epi64(s, _mm_unpackhi_epi64(s, s));
+                return _mm_cvtsi128_si64(s);
+            }
+
+            CORE_NUMERIC_TARGET_AVX2 inline double sum(const double* datos, std::size_t n) {
+                __m256d a0 = _mm256_setzero_pd(), a1 = a0, a2 = a0, a3 = a0;
+                std::size_t i = 0;
+                for (; i + 16 <= n; i += 16) {
+                    a0 = _mm256_add_pd(a0, _mm256_loadu_pd(datos + i));
+                    a1 = _mm256_add_pd(a1, _mm256_loadu_pd(datos + i + 4));
+                    a2 = _mm256_add_pd(a2, _mm256_loadu_pd(datos + i + 8));
+                    a3 = _mm256_add_pd(a3, _mm256_loadu_pd(datos + i + 12));
+                }
+                for (; i + 4 <= n; i += 4) {
+                    a0 = _mm256_add_pd(a0, _mm256_loadu_pd(datos + i));
+                }
+                double resultado = hsum(_mm256_add_pd(_mm256_add_pd(a0, a1), _mm256_add_pd(a2, a3)));
+                for (; i < n; ++i) {
+                    resultado += datos[i];
+                }
+                return resultado;
+            }
+
+            CORE_NUMERIC_TARGET_AVX2 inline float sum(const float* datos, std::size_t n) {
+                __m256 a0 = _mm256_setzero_ps(), a1 = a0, a2 = a0, a3 = a0;
+                std::size_t i = 0;
+                for (; i + 32 <= n; i += 32) {
+                    a0 = _mm256_add_ps(a0, _mm256_loadu_ps(datos + i));
+                    a1 = _mm256_add_ps(a1, _mm256_loadu_ps(datos + i + 8));
+                    a2 = _mm256_add_ps(a2, _mm256_loadu_ps(datos + i + 16));
+                    a3 = _mm256_add_ps(a3, _mm256_loadu_ps(datos + i + 24));
+                }
+                for (; i + 8 <= n; i += 8) {
+                    a0 = _mm256_add_ps(a0, _mm256_loadu_ps(datos + i));
+                }
+                float resultado = hsum(_mm256_add_ps(_mm256_add_ps(a0, a1), _mm256_add_ps(a2, a3)));
+                for (; i < n; ++i) {
+                    resultado += datos[i];
+                }
+                return resultado;
+            }
+
+            CORE_NUMERIC_TARGET_AVX2 inline std::int32_t sum(const std::int32_t* datos, std::size_t n) {
+                __m256i a0 = _mm256_setzero_si256(), a1 = a0, a2 = a0, a3 = a0;
+                std::size_t i = 0;
+                for (; i + 32 <= n; i += 32) {
+                    a0 = _mm256_add_epi32(a0, load(datos + i));
+                    a1 = _mm256_add_epi32(a1, load(datos + i + 8));
+                    a2 = _mm256_add_epi32(a2, load(datos + i + 16));
+                    a3 = _mm256_add_epi32(a3, load(datos + i + 24));
+                }
+                for (; i + 8 <= n; i += 8) {
+                    a0 = _mm256_add_epi32(a0, load(datos + i));
+                }
+                auto resultado = static_cast<std::uint32_t>(
+                    hsum_epi32(_mm256_add_epi32(_mm256_add_epi32(a0, a1), _mm256_add_epi32(a2, a3))));
+                for (; i < n; ++i) {
+                    resultado += static_cast<std::uint32_t>(datos[i]);
+                }
+                return static_cast<std::int32_t>(resultado);
+            }
+
+            CORE_NUMERIC_TARGET_AVX2 inline std::int64_t sum(const std::int64_t* datos, std::size_t n) {
+                __m256i a0 = _mm256_setzero_si256(), a1 = a0, a2 = a0, a3 = a0;
+                std::size_t i = 0;
+                for (; i + 16 <= n; i += 16) {
+                    a0 = _mm256_add_epi64(a0, load(datos + i));
+                    a1 = _mm256_add_epi64(a1, load(datos + i + 4));
+                    a2 = _mm256_add_epi64(a2, load(datos + i + 8));
+                    a3 = _mm256_add_epi64(a3, load(datos + i + 12));
+                }
+                for (; i + 4 <= n; i += 4) {
+                    a0 = _mm256_add_epi64(a0, load(datos + i));
+                }
+                auto resultado = static_cast<std::uint64_t>(
+                    hsum_epi64(_mm256_add_epi64(_mm256_add_epi64(a0, a1), _mm256_add_epi64(a2, a3))));
+                for (; i < n; ++i) {
+                    resultado += static_cast<std::uint64_t>(datos[i]);
+                }
+                return static_cast<std::int64_t>(resultado);
+            }
+
+            // max: cada acumulador empieza con el primer elemento y se actualiza con max(x, acc).
+            // maxpd devuelve el segundo operando si hay un NaN, igual que el bucle escalar
+            CORE_NUMERIC_TARGET_AVX2 inline double max(const double* datos, std::size_t n) {
+                __m256d a0 = _mm256_set1_pd(datos[0]), a1 = a0;
+                std::size_t i = 0;
+                for (; i + 8 <= n; i += 8) {
+                    a0 = _mm256_max_pd(_mm256_loadu_pd(datos + i), a0);
+                    a1 = _mm256_max_pd(_mm256_loadu_pd(datos + i + 4), a1);
+                }
+                alignas(32) double carriles[4];
+                _mm256_store_pd(carriles, _mm256_max_pd(a1, a0));
+                double maximo = portable::max(carriles, 4);
+                for (; i < n; ++i) {
+                    if (datos[i] > maximo) maximo = datos[i];
+                }
+                return maximo;
+            }
+
+            CORE_NUMERIC_TARGET_AVX2 inline float max(const float* datos, std::size_t n) {
+                __m256 a0 = _mm256_set1_ps(datos[0]), a1 = a0;
+                std::size_t i = 0;
+                for (; i + 16 <= n; i += 16) {
+                    a0 = _mm256_max_ps(_mm256_loadu_ps(datos + i), a0);
+                    a1 = _mm256_max_ps(_mm256_loadu_ps(datos + i + 8), a1);
+                }
+                alignas(32) float carriles[8];
+                _mm256_store_ps(carriles, _mm256_max_ps(a1, a0));
+                float maximo = portable::max(carriles, 8);
+                for (; i < n; ++i) {
+                    if (datos[i] > maximo) maximo = datos[i];
+                }
+                return maximo;
+            }
+
+            CORE_NUMERIC_TARGET_AVX2 inline std::int32_t max(const std::int32_t* datos, std::size_t n) {
+                __m256i a0 = _mm256_set1_epi32(datos[0]), a1 = a0;
+                std::size_t i = 0;
+                for (; i + 16 <= n; i += 16) {
+                    a0 = _mm256_max_epi32(a0, load(datos + i));
+                    a1 = _mm256_max_epi32(a1, load(datos + i + 8));
+                }
+                alignas(32) std::int32_t carriles[8];
+                _mm256_store_si256(reinterpret_cast<__m256i*>(carriles), _mm256_max_epi32(a0, a1));
+                std::int32_t maximo = portable::max(carriles, 8);
+                for (; i < n; ++i) {
+                    if (datos[i] > maximo) maximo = datos[i];
+                }
+                return maximo;
+            }
+
+            // AVX2 no tiene max para enteros de 64 bits: se compara y se mezcla
+            CORE_NUMERIC_TARGET_AVX2 inline std::int64_t max(const std::int64_t* datos, std::size_t n) {
+                __m256i a0 = _mm256_set1_epi64x(datos[0]), a1 = a0;
+                std::size_t i = 0;
+                for (; i + 8 <= n; i += 8) {
+                    __m256i x0 = load(datos + i);
+                    __m256i x1 = load(datos + i + 4);
+                    a0 = _mm256_blendv_epi8(a0, x0, _mm256_cmpgt_epi64(x0, a0));
+                    a1 = _mm256_blendv_epi8(a1, x1, _mm256_cmpgt_epi64(x1, a1));
+                }
+                a0 = _mm256_blendv_epi8(a0, a1, _mm256_cmpgt_epi64(a1, a0));
+                alignas(32) std::int64_t carriles[4];
+                _mm256_store_si256(reinterpret_cast<__m256i*>(carriles), a0);
+                std::int64_t maximo = portable::max(carriles, 4);
+                for (; i < n; ++i) {
+                    if (datos[i] > maximo) maximo = datos[i];
+                }
+                return maximo;
+            }
+
+            // min: igual que max, minpd tambien devuelve el segundo operando si hay un NaN
+            CORE_NUMERIC_TARGET_AVX2 inline double min(const double* datos, std::size_t n) {
+                __m256d a0 = _mm256_set1_pd(datos[0]), a1 = a0;
+                std::size_t i = 0;
+                for (; i + 8 <= n; i += 8) {
+                    a0 = _mm256_min_pd(_mm256_loadu_pd(datos + i), a0);
+                    a1 = _mm256_min_pd(_mm256_loadu_pd(datos + i + 4), a1);
+                }
+                alignas(32) double carriles[4];
+                _mm256_store_pd(carriles, _mm256_min_pd(a1, a0));
+                double minimo = portable::min(carriles, 4);
+                for (; i < n; ++i) {
+                    if (minimo > datos[i]) minimo = datos[i];
+                }
+                return minimo;
+            }
+
+            CORE_NUMERIC_TARGET_AVX2 inline float min(const float* datos, std::size_t n) {
+                __m256 a0 = _mm256_set1_ps(datos[0]), a1 = a0;
+                std::size_t i = 0;
+                for (; i + 16 <= n; i += 16) {
+                    a0 = _mm256_min_ps(_mm256_loadu_ps(datos + i), a0);
+                    a1 = _mm256_min_ps(_mm256_loadu_ps(datos + i + 8), a1);
+                }
+                alignas(32) float carriles[8];
+                _mm256_store_ps(carriles, _mm256_min_ps(a1, a0));
+                float minimo = portable::min(carriles, 8);
+                for (; i < n; ++i) {
+                    if (minimo > datos[i]) minimo = datos[i];
+                }
+                return minimo;
+            }
+
+            CORE_NUMERIC_TARGET_AVX2 inline std::int32_t min(const std::int32_t* datos, std::size_t n) {
+                __m256i a0 = _mm256_set1_epi32(datos[0]), a1 = a0;
+                std::size_t i = 0;
+                for (; i + 16 <= n; i += 16) {
+                    a0 = _mm256_min_epi32(a0, load(datos + i));
+                    a1 = _mm256_min_epi32(a1, load(datos + i + 8));
+                }
+                alignas(32) std::int32_t carriles[8];
+                _mm256_store_si256(reinterpret_cast<__m256i*>(carriles), _mm256_min_epi32(a0, a1));
+                std::int32_t minimo = portable::min(carriles, 8);
+                for (; i < n; ++i) {
+                    if (minimo > datos[i]) minimo = datos[i];
+                }
+                return minimo;
+            }
+
+            CORE_NUMERIC_TARGET_AVX2 inline std::int64_t min(const std::int64_t* datos, std::size_t n) {
+                __m256i a0 = _mm256_set1_epi64x(datos[0]), a1 = a0;
+                std::size_t i = 0;
+                for (; i + 8 <= n; i += 8) {
+                    __m256i x0 = load(datos + i);
+                    __m256i x1 = load(datos + i + 4);
+                    a0 = _mm256_blendv_epi8(a0, x0, _mm256_cmpgt_epi64(a0, x0));
+                    a1 = _mm256_blendv_epi8(a1, x1, _mm256_cmpgt_epi64(a1, x1));
+                }
+                a0 = _mm256_blendv_epi8(a0, a1, _mm256_cmpgt_epi64(a0, a1));
+                alignas(32) std::int64_t carriles[4];
+                _mm256_store_si256(reinterpret_cast<__m256i*>(carriles), a0);
+                std::int64_t minimo = portable::min(carriles, 4);
+                for (; i < n; ++i) {
+                    if (minimo > datos[i]) minimo = datos[i];
+                }
+                return minimo;
+            }
+
+            // Extremos con posicion: operaciones por tipo (lanes<T>) y un kernel comun.
+            // Las posiciones viajan en carriles enteros del mismo ancho que los valores;
+            // greater devuelve una mascara de carril completo, falsa si hay un NaN (_CMP_GT_OQ)
+            template <typename T>
+            struct lanes;
+
+            template <>
+            struct lanes<double> {
+                using vec = __m256d;
+                using pos_t = std::uint64_t;
+                static constexpr std::size_t carriles = 4;
+                static CORE_NUMERIC_TARGET_AVX2 vec set1(double x) { return _mm256_set1_pd(x); }
+                static CORE_NUMERIC_TARGET_AVX2 vec load(const double* p) { return _mm256_loadu_pd(p); }
+                static CORE_NUMERIC_TARGET_AVX2 void store(double* p, vec v) { _mm256_store_pd(p, v); }
+                static CORE_NUMERIC_TARGET_AVX2 __m256i greater(vec a, vec b) { return _mm256_castpd_si256(_mm256_cmp_pd(a, b, _CMP_GT_OQ)); }
+                static CORE_NUMERIC_TARGET_AVX2 vec select(__m256i m, vec a, vec b) { return _mm256_blendv_pd(a, b, _mm256_castsi256_pd(m)); }
+                static CORE_NUMERIC_TARGET_AVX2 __m256i positions(pos_t base) { return _mm256_add_epi64(_mm256_set1_epi64x(static_cast<long long>(base)), _mm256_setr_epi64x(0, 1, 2, 3)); }
+                static CORE_NUMERIC_TARGET_AVX2 __m256i advance(__m256i p, pos_t paso) { return _mm256_add_epi64(p, _mm256_set1_epi64x(static_cast<long long>(paso))); }
+            };
+
+            template <>
+            struct lanes<std::int64_t> {
+                using vec = __m256i;
+                using pos_t = std::uint64_t;
+                static constexpr std::size_t carriles = 4;
+                static CORE_NUMERIC_TARGET_AVX2 vec set1(std::int64_t x) { return _mm256_set1_epi64x(x); }
+                static CORE_NUMERIC_TARGET_AVX2 vec load(const std::int64_t* p) { return avx2::load(p); }
+                static CORE_NUMERIC_TARGET_AVX2 void store(std::int64_t* p, vec v) { _mm256_store_si256(reinterpret_cast<__m256i*>(p), v); }
+                static CORE_NUMERIC_TARGET_AVX2 __m256i greater(vec a, vec b) { return _mm256_cmpgt_epi64(a, b); }
+                static CORE_NUMERIC_TARGET_AVX2 vec select(__m256i m, vec a, vec b) { return _mm256_blendv_epi8(a, b, m); }
+                static CORE_NUMERIC_TARGET_AVX2 __m256i positions(pos_t base) { return lanes<double>::positions(base); }
+                static CORE_NUMERIC_TARGET_AVX2 __m256i advance(__m256i p, pos_t paso) { return lanes<double>::advance(p, paso); }
+            };
+
+            // float e int32 llevan posiciones de 32 bits: el despacho no los manda aqui con 2^32 elementos o mas
+            template <>
+            struct lanes<float> {
+                using vec = __m256;
+                using pos_t = std::uint32_t;
+                static constexpr std::size_t carriles = 8;
+                static CORE_NUMERIC_TARGET_AVX2 vec set1(float x) { return _mm256_set1_ps(x); }
+                static CORE_NUMERIC_TARGET_AVX2 vec load(const float* p) { return _mm256_loadu_ps(p); }
+                static CORE_NUMERIC_TARGET_AVX2 void store(float* p, vec v) { _mm256_store_ps(p, v); }
+                static CORE_NUMERIC_TARGET_AVX2 __m256i greater(vec a, vec b) { return _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_GT_OQ)); }
+                static CORE_NUMERIC_TARGET_AVX2 vec select(__m256i m, vec a, vec b) { return _mm256_blendv_ps(a, b, _mm256_castsi256_ps(m)); }
+                static CORE_NUMERIC_TARGET_AVX2 __m256i positions(pos_t base) { return _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(base)), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7)); }
+                static CORE_NUMERIC_TARGET_AVX2 __m256i advance(__m256i p, pos_t paso) { return _mm256_add_epi32(p, _mm256_set1_epi32(static_cast<int>(paso))); }
+            };
+
+            template <>
+            struct lanes<std::int32_t> {
+                using vec = __m256i;
+                using pos_t = std::uint32_t;
+                static constexpr std::size_t carriles = 8;
+                static CORE_NUMERIC_TARGET_AVX2 vec set1(std::int32_t x) { return _mm256_set1_epi32(x); }
+                static CORE_NUMERIC_TARGET_AVX2 vec load(const std::int32_t* p) { return avx2::load(p); }
+                static CORE_NUMERIC_TARGET_AVX2 void store(std::int32_t* p, vec v) { _mm256_store_si256(reinterpret_cast<__m256i*>(p), v); }
+                static CORE_NUMERIC_TARGET_AVX2 __m256i greater(vec a, vec b) { return _mm256_cmpgt_epi32(a, b); }
+                static CORE_NUMERIC_TARGET_AVX2 vec select(__m256i m, vec a, vec b) { return _mm256_blendv_epi8(a, b, m); }
+                static CORE_NUMERIC_TARGET_AVX2 __m256i positions(pos_t base) { return lanes<float>::positions(base); }
+                static CORE_NUMERIC_TARGET_AVX2 __m256i advance(__m256i p, pos_t paso) { return lanes<float>::advance(p, paso); }
+            };
+
+            // Dos juegos de registros por extremo para no depender de la latencia de comparar y mezclar
+            template <bool Min, bool Max, typename T>
+            CORE_NUMERIC_TARGET_AVX2 minmax_result<T> extremes(const T* datos, std::size_t n) {
+                using L = lanes<T>;
+                constexpr std::size_t C = L::carriles;
+                auto mayor0 = L::set1(datos[0]), mayor1 = mayor0, menor0 = mayor0, menor1 = mayor0;
+                __m256i pos_mayor0 = _mm256_setzero_si256(), pos_mayor1 = pos_mayor0, pos_menor0 = pos_mayor0, pos_menor1 = pos_mayor0;
+                __m256i actual0 = L::positions(0), actual1 = L::positions(C);
+                std::size_t i = 0;
+                for (; i + 2 * C <= n; i += 2 * C) {
+                    auto x0 = L::load(datos + i);
+                    auto x1 = L::load(datos + i + C);
+                    if constexpr (Max) {
+                        __m256i m0 = L::greater(x0, mayor0), m1 = L::greater(x1, mayor1);
+                        mayor0 = L::select(m0, mayor0, x0);
+                        mayor1 = L::select(m1, mayor1, x1);
+                        pos_mayor0 = _mm256_blendv_epi8(pos_mayor0, actual0, m0);
+                        pos_mayor1 = _mm256_blendv_epi8(pos_mayor1, actual1, m1);
+                    }
+                    if constexpr (Min) {
+                        __m256i m0 = L::greater(menor0, x0), m1 = L::greater(menor1, x1);
+                        menor0 = L::select(m0, menor0, x0);
+                        menor1 = L::select(m1, menor1, x1);
+                        pos_menor0 = _mm256_blendv_epi8(pos_menor0, actual0, m0);
+                        pos_menor1 = _mm256_blendv_epi8(pos_menor1, actual1, m1);
+                    }
+                    actual0 = L::advance(actual0, 2 * C);
+                    actual1 = L::advance(actual1, 2 * C);
+                }
+                alignas(32) T valores[2 * C];
+                alignas(32) typename L::pos_t posiciones[2 * C];
+                minmax_result<T> resultado;
+                if constexpr (Max) {
+                    L::store(valores, mayor0);
+                    L::store(valores + C, mayor1);
+                    _mm256_store_si256(reinterpret_cast<__m256i*>(posiciones), pos_mayor0);
+                    _mm256_store_si256(reinterpret_cast<__m256i*>(posiciones + C), pos_mayor1);
+                    resultado.max = portable::best_lane<false>(valores, posiciones, 2 * C);
+                }
+                if constexpr (Min) {
+                    L::store(valores, menor0);
+                    L::store(valores + C, menor1);
+                    _mm256_store_si256(reinterpret_cast<__m256i*>(posiciones), pos_menor0);
+                    _mm256_store_si256(reinterpret_cast<__m256i*>(posiciones + C), pos_menor1);
+                    resultado.min = portable::best_lane<true>(valores, posiciones, 2 * C);
+                }
+                portable::extremes_tail<Min, Max>(resultado, datos, i, n);
+                return resultado;
+            }
+
+            CORE_NUMERIC_TARGET_AVX2 inline double sum_sq_dev(const double* datos, std::size_t n, double media) {
+                const __m256d m = _mm256_set1_pd(media);
+                __m256d a0 = _mm256_setzero_pd(), a1 = a0, a2 = a0, a3 = a0;
+                std::size_t i = 0;
+                for (; i + 16 <= n; i += 16) {
+                    __m256d d0 = _mm256_sub_pd(_mm256_loadu_pd(datos + i), m);
+                    __m256d d1 = _mm256_sub_pd(_mm256_loadu_pd(datos + i + 4), m);
+                    __m256d d2 = _mm256_sub_pd(_mm256_loadu_pd(datos + i + 8), m);
+                    __m256d d3 = _mm256_sub_pd(_mm256_loadu_pd(datos + i + 12), m);
+                    a0 = _mm256_fmadd_pd(d0, d0, a0);
+                    a1 = _mm256_fmadd_pd(d1, d1, a1);
+                    a2 = _mm256_fmadd_pd(d2, d2, a2);
+                    a3 = _mm256_fmadd_pd(d3, d3, a3);
+                }
+                for (; i + 4 <= n; i += 4) {
+                    __m256d d = _mm256_sub_pd(_mm256_loadu_pd(datos + i), m);
+                    a0 = _mm256_fmadd_pd(d, d, a0);
+                }
+                double resultado = hsum(_mm256_add_pd(_mm256_add_pd(a0, a1), _mm256_add_pd(a2, a3)));
+                for (; i < n; ++i) {
+                    double diff = datos[i] - media;
+                    resultado += diff * diff;
+                }
+                return resultado;
+            }
+
+            CORE_NUMERIC_TARGET_AVX2 inline float sum_sq_dev(const float* datos, std::size_t n, float media) {
+                const __m256 m = _mm256_set1_ps(media);
+                __m256 a0 = _mm256_setzero_ps(), a1 = a0, a2 = a0, a3 = a0;
+                std::size_t i = 0;
+                for (; i + 32 <= n; i += 32) {
+                    __m256 d0 = _mm256_sub_ps(_mm256_loadu_ps(datos + i), m);
+                    __m256 d1 = _mm256_sub_ps(_mm256_loadu_ps(datos + i + 8), m);
+                    __m256 d2 = _mm256_sub_ps(_mm256_loadu_ps(datos + i + 16), m);
+                    __m256 d3 = _mm256_sub_ps(_mm256_loadu_ps(datos + i + 24), m);
+                    a0 = _mm256_fmadd_ps(d0, d0, a0);
+                    a1 = _mm256_fmadd_ps(d1, d1, a1);
+                    a2 = _mm256_fmadd_ps(d2, d2, a2);
+                    a3 = _mm256_fmadd_ps(d3, d3, a3);
+                }
+                for (; i + 8 <= n; i += 8) {
+                    __m256 d = _mm256_sub_ps(_mm256_loadu_ps(datos + i), m);
+                    a0 = _mm256_fmadd_ps(d, d, a0);
+                }
+                float resultado = hsum(_mm256_add_ps(_mm256_add_ps(a0, a1), _mm256_add_ps(a2, a3)));
+                for (; i < n; ++i) {
+                    float diff = datos[i] - media;
+                    resultado += diff * diff;
+                }
+                return resultado;
+            }
+
+            template <typename T, typename A, typename Op, typename Func>
+            CORE_NUMERIC_TARGET_AVX2 A transform_fold(const T* datos, std::size_t n, A inicial, Op& op, Func& funcion) {
+                return portable::transform_fold(datos, n, inicial, op, funcion);
+            }
+
+            template <typename T, typename U, typename A, typename Op, typename Func>
+            CORE_NUMERIC_TARGET_AVX2 A transform_fold(const T* a, const U* b, std::size_t n, A inicial, Op& op, Func& funcion) {
+                return portable::transform_fold(a, b, n, inicial, op, funcion);
+            }
+
+            // Producto escalar con FMA y 4 acumuladores, para no esperar la latencia de cada fmadd
+            CORE_NUMERIC_TARGET_AVX2 inline double dot(const double* a, const double* b, std::size_t n) {
+                __m256d a0 = _mm256_setzero_pd(), a1 = a0, a2 = a0, a3 = a0;
+                std::size_t i = 0;
+                for (; i + 16 <= n; i += 16) {
+                    a0 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i), a0);
+                    a1 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4), a1);
+                    a2 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 8), _mm256_loadu_pd(b + i + 8), a2);
+                    a3 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 12), _mm256_loadu_pd(b + i + 12), a3);
+                }
+                for (; i + 4 <= n; i += 4) {
+                    a0 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i), a0);
+                }
+                double resultado = hsum(_mm256_add_pd(_mm256_add_pd(a0, a1), _mm256_add_pd(a2, a3)));
+                for (; i < n; ++i) {
+                    resultado += a[i] * b[i];
+                }
+                return resultado;
+            }
+
+            CORE_NUMERIC_TARGET_AVX2 inline float dot(const float* a, const float* b, std::size_t n) {
+                __m256 a0 = _mm256_setzero_ps(), a1 = a0, a2 = a0, a3 = a0;
+                std::size_t i = 0;
+                for (; i + 32 <= n; i += 32) {
+                    a0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), a0);
+                    a1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8), a1);
+                    a2 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 16), _mm256_loadu_ps(b + i + 16), a2);
+                    a3 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 24), _mm256_loadu_ps(b + i + 24), a3);
+                }
+                for (; i + 8 <= n; i += 8) {
+                    a0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), a0);
+                }
+                float resultado = hsum(_mm256_add_ps(_mm256_add_ps(a0, a1), _mm256_add_ps(a2, a3)));
+                for (; i < n; ++i) {
+                    resultado += a[i] * b[i];
+                }
+                return resultado;
+            }
+
+            // Paso de TwoSum en cada carril: s += x y el error exacto de la suma se acumula en c
+            CORE_NUMERIC_TARGET_AVX2 inline void two_sum(__m256d& s, __m256d& c, __m256d x) {
+                __m256d t = _mm256_add_pd(s, x);
+                __m256d z = _mm256_sub_pd(t, s);
+                __m256d e = _mm256_add_pd(_mm256_sub_pd(s, _mm256_sub_pd(t, z)), _mm256_sub_pd(x, z));
+                c = _mm256_add_pd(c, e);
+                s = t;
+            }
+
+            CORE_NUMERIC_TARGET_AVX2 inline void two_sum(__m256& s, __m256& c, __m256 x) {
+                __m256 t = _mm256_add_ps(s, x);
+                __m256 z = _mm256_sub_ps(t, s);
+                __m256 e = _mm256_add_ps(_mm256_sub_ps(s, _mm256_sub_ps(t, z)), _mm256_sub_ps(x, z));
+                c = _mm256_add_ps(c, e);
+                s = t;
+            }
+
+            // Suma compensada: 4 pares (suma, error) independientes para no depender de la latencia
+            CORE_NUMERIC_TARGET_AVX2 inline double kbn_sum(const double* datos, std::size_t n) {
+                __m256d s0 = _mm256_setzero_pd(), c0 = s0, s1 = s0, c1 = s0, s2 = s0, c2 = s0, s3 = s0, c3 = s0;
+                std::size_t i = 0;
+                for (; i + 16 <= n; i += 16) {
+                    two_sum(s0, c0, _mm256_loadu_pd(datos + i));
+                    two_sum(s1, c1, _mm256_loadu_pd(datos + i + 4));
+                    two_sum(s2, c2, _mm256_loadu_pd(datos + i + 8));
+                    two_sum(s3, c3, _mm256_loadu_pd(datos + i + 12));
+                }
+                alignas(32) double s[16];
+                alignas(32) double c[16];
+                _mm256_store_pd(s, s0);
+                _mm256_store_pd(s + 4, s1);
+                _mm256_store_pd(s + 8, s2);
+                _mm256_store_pd(s + 12, s3);
+                _mm256_store_pd(c, c0);
+                _mm256_store_pd(c + 4, c1);
+                _mm256_store_pd(c + 8, c2);
+                _mm256_store_pd(c + 12, c3);
+                return portable::kbn_finish(s, c, 16, datos + i, n - i);
+            }
+
+            CORE_NUMERIC_TARGET_AVX2 inline float kbn_sum(const float* datos, std::size_t n) {
+                __m256 s0 = _mm256_setzero_ps(), c0 = s0, s1 = s0, c1 = s0, s2 = s0, c2 = s0, s3 = s0, c3 = s0;
+                std::size_t i = 0;
+                for (; i + 32 <= n; i += 32) {
+                    two_sum(s0, c0, _mm256_loadu_ps(datos + i));
+                    two_sum(s1, c1, _mm256_loadu_ps(datos + i + 8));
+                    two_sum(s2, c2, _mm256_loadu_ps(datos + i + 16));
+                    two_sum(s3, c3, _mm256_loadu_ps(datos + i + 24));
+                }
+                alignas(32) float s[32];
+                alignas(32) float c[32];
+                _mm256_store_ps(s, s0);
+                _mm256_store_ps(s + 8, s1);
+                _mm256_store_ps(s + 16, s2);
+                _mm256_store_ps(s + 24, s3);
+                _mm256_store_ps(c, c0);
+                _mm256_store_ps(c + 8, c1);
+                _mm256_store_ps(c + 16, c2);
+                _mm256_store_ps(c + 24, c3);
+                return portable::kbn_finish(s, c, 32, datos + i, n - i);
+            }
+
+            // Carga 4 int32 extendidos a 64 bits (vpmovsxdq)
+            CORE_NUMERIC_TARGET_AVX2 inline __m256i load_widen(const std::int32_t* p) {
+                return _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+            }
+
+            // Suma ensanchada de int32 en int64: cada entero se extiende a 64 bits antes de sumar, sin desborde
+            CORE_NUMERIC_TARGET_AVX2 inline std::int64_t wide_sum(const std::int32_t* datos, std::size_t n) {
+                __m256i a0 = _mm256_setzero_si256(), a1 = a0, a2 = a0, a3 = a0;
+                std::size_t i = 0;
+                for (; i + 16 <= n; i += 16) {
+                    a0 = _mm256_add_epi64(a0, load_widen(datos + i));
+                    a1 = _mm256_add_epi64(a1, load_widen(datos + i + 4));
+                    a2 = _mm256_add_epi64(a2, load_widen(datos + i + 8));
+                    a3 = _mm256_add_epi64(a3, load_widen(datos + i + 12));
+                }
+                for (; i + 4 <= n; i += 4) {
+                    a0 = _mm256_add_epi64(a0, load_widen(datos + i));
+                }
+                std::int64_t resultado = hsum_epi64(_mm256_add_epi64(_mm256_add_epi64(a0, a1), _mm256_add_epi64(a2, a3)));
+                for (; i < n; ++i) {
+                    resultado += datos[i];
+                }
+                return resultado;
+            }
+
+#if CORE_NUMERIC_HAS_INT128
+            // Acumulador de 128 bits por carril: 'bajo' suma sin signo y 'alto' cuenta los acarreos.
+            // AVX2 no compara sin signo, asi que se invierte el bit de signo y se compara con signo
+            CORE_NUMERIC_TARGET_AVX2 inline void add_wide(__m256i& bajo, __m256i& alto, __m256i x, __m256i extension) {
+                const __m256i sesgo = _mm256_set1_epi64x(std::numeric_limits<std::int64_t>::min());
+                __m256i suma = _mm256_add_epi64(bajo, x);
+                __m256i acarreo = _mm256_cmpgt_epi64(_mm256_xor_si256(x, sesgo), _mm256_xor_si256(suma, sesgo));
+                alto = _mm256_add_epi64(_mm256_sub_epi64(alto, acarreo), extension);
+                bajo = suma;
+            }
+
+            // Suma de int64 en 128 bits. La extension de signo de x (-1 si es negativo) se suma a la parte alta
+            CORE_NUMERIC_TARGET_AVX2 inline int128 wide_sum(const std::int64_t* datos, std::size_t n) {
+                const __m256i cero = _mm256_setzero_si256();
+                __m256i b0 = cero, h0 = cero, b1 = cero, h1 = cero;
+                std::size_t i = 0;
+                for (; i + 8 <= n; i += 8) {
+                    __m256i x0 = load(datos + i);
+                    __m256i x1 = load(datos + i + 4);
+                    add_wide(b0, h0, x0, _mm256_cmpgt_epi64(cero, x0));
+                    add_wide(b1, h1, x1, _mm256_cmpgt_epi64(cero, x1));
+                }
+                alignas(32) std::uint64_t bajo[8];
+                alignas(32) std::uint64_t alto[8];
+                _mm256_store_si256(reinterpret_cast<__m256i*>(bajo), b0);
+                _mm256_store_si256(reinterpret_cast<__m256i*>(bajo + 4), b1);
+                _mm256_store_si256(reinterpret_cast<__m256i*>(alto), h0);
+                _mm256_store_si256(reinterpret_cast<__m256i*>(alto + 4), h1);
+                uint128 resultado = portable::join_wide(bajo, alto, 8);
+                for (; i < n; ++i) {
+                    resultado += static_cast<uint128>(static_cast<int128>(datos[i]));
+                }
+                return static_cast<int128>(resultado);
+            }
+
+            // Suma de cuadrados de int32: vpmuldq multiplica los carriles pares (con signo, 32x32 -> 64 bits);
+            // los impares se bajan con un desplazamiento. Los cuadrados no son negativos: sin extension de signo
+            CORE_NUMERIC_TARGET_AVX2 inline uint128 sum_squares(const std::int32_t* datos, std::size_t n) {
+                const __m256i cero = _mm256_setzero_si256();
+                __m256i b0 = cero, h0 = cero, b1 = cero, h1 = cero;
+                std::size_t i = 0;
+                for (; i + 8 <= n; i += 8) {
+                    __m256i x = load(datos + i);
+                    __m256i impares = _mm256_srli_epi64(x, 32);
+                    add_wide(b0, h0, _mm256_mul_epi32(x, x), cero);
+                    add_wide(b1, h1, _mm256_mul_epi32(impares, impares), cero);
+                }
+                alignas(32) std::uint64_t bajo[8];
+                alignas(32) std::uint64_t alto[8];
+                _mm256_store_si256(reinterpret_cast<__m256i*>(bajo), b0);
+                _mm256_store_si256(reinterpret_cast<__m256i*>(bajo + 4), b1);
+                _mm256_store_si256(reinterpret_cast<__m256i*>(alto), h0);
+                _mm256_store_si256(reinterpret_cast<__m256i*>(alto + 4), h1);
+                return portable::join_wide(bajo, alto, 8) + portable::sum_squares(datos + i, n - i);
+            }
+#endif
+        } // namespace avx2
+
+        // Kernels AVX-512 (registros de 512 bits). La cola se procesa con cargas enmascaradas,
+        // asi no hace falta un bucle escalar al final.
+        // Los intrinsics AVX-512 de GCC 12 inicializan su registro "undefined" consigo mismo
+        // y disparan -Wuninitialized falsos; se silencian solo en este bloque
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+        namespace avx512 {
+
+            // Mascara con los primeros 'resto' carriles activos
+            CORE_NUMERIC_TARGET_AVX512 inline __mmask16 tail_mask(std::size_t resto) {
+                return static_cast<__mmask16>((1u << resto) - 1u);
+            }
+
+            // Mitades de 256 bits de un registro de 512.
+            // Se usan las variantes maskz porque los casts de GCC 12 disparan -Wuninitialized
+            CORE_NUMERIC_TARGET_AVX512 inline __m256d half(__m512d v, std::size_t i) {
+                return i == 0 ? _mm512_maskz_extractf64x4_pd(0xFF, v, 0) : _mm512_maskz_extractf64x4_pd(0xFF, v, 1);
+            }
+
+            CORE_NUMERIC_TARGET_AVX512 inline __m256i half(__m512i v, std::size_t i) {
+                return i == 0 ? _mm512_maskz_extracti64x4_epi64(0xFF, v, 0) : _mm512_maskz_extracti64x4_epi64(0xFF, v, 1);
+            }
+
+            // Reducciones horizontales: se suman las dos mitades y se reutiliza la reduccion AVX2
+            CORE_NUMERIC_TARGET_AVX512 inline double hsum(__m512d v) {
+                return avx2::hsum(_mm256_add_pd(half(v, 0), half(v, 1)));
+            }
+
+            CORE_NUMERIC_TARGET_AVX512 inline float hsum(__m512 v) {
+                __m512d bits = _mm512_castps_pd(v);
+                return avx2::hsum(_mm256_add_ps(_mm256_castpd_ps(half(bits, 0)), _mm256_castpd_ps(half(bits, 1))));
+            }
+
+            CORE_NUMERIC_TARGET_AVX512 inline std::int32_t hsum_epi32(__m512i v) {
+                return avx2::hsum_epi32(_mm256_add_epi32(half(v, 0), half(v, 1)));
+            }
+
+            CORE_NUMERIC_TARGET_AVX512 inline std::int64_t hsum_epi64(__m512i v) {
+                return avx2::hsum_epi64(_mm256_add_epi64(half(v, 0), half(v, 1)));
+            }
+
+            CORE_NUMERIC_TARGET_AVX512 inline double sum(const double* datos, std::size_t n) {
+                __m512d a0 = _mm512_setzero_pd(), a1 = a0, a2 = a0, a3 = a0;
+                std::size_t i = 0;
+                for (; i + 32 <= n; i += 32) {
+                    a0 = _mm512_add_pd(a0, _mm512_loadu_pd(datos + i));
+                    a1 = _mm512_add_pd(a1, _mm512_loadu_pd(datos + i + 8));
+                    a2 = _mm512_add_pd(a2, _mm512_loadu_pd(datos + i + 16));
+                    a3 = _mm512_add_pd(a3, _mm512_loadu_pd(datos + i + 24));
+                }
+                for (; i + 8 <= n; i += 8) {
+                    a0 = _mm512_add_pd(a0, _mm512_loadu_pd(datos + i));
+                }
+                if (i < n) {
+                    a1 = _mm512_add_pd(a1, _mm512_maskz_loadu_pd(static_cast<__mmask8>(tail_mask(n - i)), datos + i));
+                }
+                return hsum(_mm512_add_pd(_mm512_add_pd(a0, a1), _mm512_add_pd(a2, a3)));
+            }
+
+            CORE_NUMERIC_TARGET_AVX512 inline float sum(const float* datos, std::size_t n) {
+                __m512 a0 = _mm512_setzero_ps(), a1 = a0, a2 = a0, a3 = a0;
+                std::size_t i = 0;
+                for (; i + 64 <= n; i += 64) {
+                    a0 = _mm512_add_ps(a0, _mm512_loadu_ps(datos + i));
+                    a1 = _mm512_add_ps(a1, _mm512_loadu_ps(datos + i + 16));
+                    a2 = _mm512_add_ps(a2, _mm512_loadu_ps(datos + i + 32));
+                    a3 = _mm512_add_ps(a3, _mm512_loadu_ps(datos + i + 48));
+                }
+                for (; i + 16 <= n; i += 16) {
+                    a0 = _mm512_add_ps(a0, _mm512_loadu_ps(datos + i));
+                }
+                if (i < n) {
+                    a1 = _mm512_add_ps(a1, _mm512_maskz_loadu_ps(tail_mask(n - i), datos + i));
+                }
+                return hsum(_mm512_add_ps(_mm512_add_ps(a0, a1), _mm512_add_ps(a2, a3)));
+            }
+
+            CORE_NUMERIC_TARGET_AVX512 inline std::int32_t sum(const std::int32_t* datos, std::size_t n) {
+                __m512i a0 = _mm512_setzero_si512(), a1 = a0, a2 = a0, a3 = a0;
+                std::size_t i = 0;
+                for (; i + 64 <= n; i += 64) {
+                    a0 = _mm512_add_epi32(a0, _mm512_loadu_si512(datos + i));
+                    a1 = _mm512_add_epi32(a1, _mm512_loadu_si512(datos + i + 16));
+                    a2 = _mm512_add_epi32(a2, _mm512_loadu_si512(datos + i + 32));
+                    a3 = _mm512_add_epi32(a3, _mm512_loadu_si512(datos + i + 48));
+                }
+                for (; i + 16 <= n; i += 16) {
+                    a0 = _mm512_add_epi32(a0, _mm512_loadu_si512(datos + i));
+                }
+                if (i < n) {
+                    a1 = _mm512_add_epi32(a1, _mm512_maskz_loadu_epi32(tail_mask(n - i), datos + i));
+                }
+                return hsum_epi32(_mm512_add_epi32(_mm512_add_epi32(a0, a1), _mm512_add_epi32(a2, a3)));
+            }
+
+            CORE_NUMERIC_TARGET_AVX512 inline std::int64_t sum(const std::int64_t* datos, std::size_t n) {
+                __m512i a0 = _mm512_setzero_si512(), a1 = a0, a2 = a0, a3 = a0;
+                std::size_t i = 0;
+                for (; i + 32 <= n; i += 32) {
+                    a0 = _mm512_add_epi64(a0, _mm512_loadu_si512(datos + i));
+                    a1 = _mm512_add_epi64(a1, _mm512_loadu_si512(datos + i + 8));
+                    a2 = _mm512_add_epi64(a2, _mm512_loadu_si512(datos + i + 16));
+                    a3 = _mm512_add_epi64(a3, _mm512_loadu_si512(datos + i + 24));
+                }
+                for (; i + 8 <= n; i += 8) {
+                    a0 = _mm512_add_epi64(a0, _mm512_loadu_si512(datos + i));
+                }
+                if (i < n) {
+                    a1 = _mm512_add_epi64(a1, _mm512_maskz_loadu_epi64(static_cast<__mmask8>(tail_mask(n - i)), datos + i));
+                }
+                return hsum_epi64(_mm512_add_epi64(_mm512_add_epi64(a0, a1), _mm512_add_epi64(a2, a3)));
+            }
+
+            // max: misma semantica que en AVX2. En la cola solo se actualizan los carriles cargados
+            CORE_NUMERIC_TARGET_AVX512 inline double max(const double* datos, std::size_t n) {
+                __m512d a0 = _mm512_set1_pd(datos[0]), a1 = a0;
+                std::size_t i = 0;
+                for (; i + 16 <= n; i += 16) {
+                    a0 = _mm512_max_pd(_mm512_loadu_pd(datos + i), a0);
+                    a1 = _mm512_max_pd(_mm512_loadu_pd(datos + i + 8), a1);
+                }
+                for (; i + 8 <= n; i += 8) {
+                    a0 = _mm512_max_pd(_mm512_loadu_pd(datos + i), a0);
+                }
+                if (i < n) {
+                    auto m = static_cast<__mmask8>(tail_mask(n - i));
+                    a1 = _mm512_mask_max_pd(a1, m, _mm512_maskz_loadu_pd(m, datos + i), a1);
+                }
+                alignas(64) double carriles[8];
+                _mm512_store_pd(carriles, _mm512_max_pd(a1, a0));
+                return portable::max(carriles, 8);
+            }
+
+            CORE_NUMERIC_TARGET_AVX512 inline float max(const float* datos, std::size_t n) {
+                __m512 a0 = _mm512_set1_ps(datos[0]), a1 = a0;
+                std::size_t i = 0;
+                for (; i + 32 <= n; i += 32) {
+                    a0 = _mm512_max_ps(_mm512_loadu_ps(datos + i), a0);
+                    a1 = _mm512_max_ps(_mm512_loadu_ps(datos + i + 16), a1);
+                }
+                for (; i + 16 <= n; i += 16) {
+                    a0 = _mm512_max_ps(_mm512_loadu_ps(datos + i), a0);
+                }
+                if (i < n) {
+                    __mmask16 m = tail_mask(n - i);
+                    a1 = _mm512_mask_max_ps(a1, m, _mm512_maskz_loadu_ps(m, datos + i), a1);
+                }
+                alignas(64) float carriles[16];
+                _mm512_store_ps(carriles, _mm512_max_ps(a1, a0));
+                return portable::max(carriles, 16);
+            }
+
+            CORE_NUMERIC_TARGET_AVX512 inline std::int32_t max(const std::int32_t* datos, std::size_t n) {
+                __m512i a0 = _mm512_set1_epi32(datos[0]), a1 = a0;
+                std::size_t i = 0;
+                for (; i + 32 <= n; i += 32) {
+                    a0 = _mm512_max_epi32(a0, _mm512_loadu_si512(datos + i));
+                    a1 = _mm512_max_epi32(a1, _mm512_loadu_si512(datos + i + 16));
+                }
+                for (; i + 16 <= n; i += 16) {
+                    a0 = _mm512_max_epi32(a0, _mm512_loadu_si512(datos + i));
+                }
+                if (i < n) {
+                    __mmask16 m = tail_mask(n - i);
+                    a1 = _mm512_mask_max_epi32(a1, m, a1, _mm512_maskz_loadu_epi32(m, datos + i));
+                }
+                return _mm512_reduce_max_epi32(_mm512_max_epi32(a0, a1));
+            }
+
+            CORE_NUMERIC_TARGET_AVX512 inline std::int64_t max(const std::int64_t* datos, std::size_t n) {
+                __m512i a0 = _mm512_set1_epi64(datos[0]), a1 = a0;
+                std::size_t i = 0;
+                for (; i + 16 <= n; i += 16) {
+                    a0 = _mm512_max_epi64(a0, _mm512_loadu_si512(datos + i));
+                    a1 = _mm512_max_epi64(a1, _mm512_loadu_si512(datos + i + 8));
+                }
+                for (; i + 8 <= n; i += 8) {
+                    a0 = _mm512_max_epi64(a0, _mm512_loadu_si512(datos + i));
+                }
+                if (i < n) {
+                    auto m = static_cast<__mmask8>(tail_mask(n - i));
+                    a1 = _mm512_mask_max_epi64(a1, m, a1, _mm512_maskz_loadu_epi64(m, datos + i));
+                }
+                alignas(64) std::int64_t carriles[8];
+                _mm512_store_si512(carriles, _mm512_max_epi64(a0, a1));
+                return portable::max(carriles, 8);
+            }
+
+            // min: misma semantica que max
+            CORE_NUMERIC_TARGET_AVX512 inline double min(const double* datos, std::size_t n) {
+                __m512d a0 = _mm512_set1_pd(datos[0]), a1 = a0;
+                std::size_t i = 0;
+                for (; i + 16 <= n; i += 16) {
+                    a0 = _mm512_min_pd(_mm512_loadu_pd(datos + i), a0);
+                    a1 = _mm512_min_pd(_mm512_loadu_pd(datos + i + 8), a1);
+                }
+                for (; i + 8 <= n; i += 8) {
+                    a0 = _mm512_min_pd(_mm512_loadu_pd(datos + i), a0);
+                }
+                if (i < n) {
+                    auto m = static_cast<__mmask8>(tail_mask(n - i));
+                    a1 = _mm512_mask_min_pd(a1, m, _mm512_maskz_loadu_pd(m, datos + i), a1);
+                }
+                alignas(64) double carriles[8];
+                _mm512_store_pd(carriles, _mm512_min_pd(a1, a0));
+                return portable::min(carriles, 8);
+            }
+
+            CORE_NUMERIC_TARGET_AVX512 inline float min(const float* datos, std::size_t n) {
+                __m512 a0 = _mm512_set1_ps(datos[0]), a1 = a0;
+                std::size_t i = 0;
+                for (; i + 32 <= n; i += 32) {
+                    a0 = _mm512_min_ps(_mm512_loadu_ps(datos + i), a0);
+                    a1 = _mm512_min_ps(_mm512_loadu_ps(datos + i + 16), a1);
+                }
+                for (; i + 16 <= n; i += 16) {
+                    a0 = _mm512_min_ps(_mm512_loadu_ps(datos + i), a0);
+                }
+                if (i < n) {
+                    __mmask16 m = tail_mask(n - i);
+                    a1 = _mm512_mask_min_ps(a1, m, _mm512_maskz_loadu_ps(m, datos + i), a1);
+                }
+                alignas(64) float carriles[16];
+                _mm512_store_ps(carriles, _mm512_min_ps(a1, a0));
+                return portable::min(carriles, 16);
+            }
+
+            CORE_NUMERIC_TARGET_AVX512 inline std::int32_t min(const std::int32_t* datos, std::size_t n) {
+                __m512i a0 = _mm512_set1_epi32(datos[0]), a1 = a0;
+                std::size_t i = 0;
+                for (; i + 32 <= n; i += 32) {
+                    a0 = _mm512_min_epi32(a0, _mm512_loadu_si512(datos + i));
+                    a1 = _mm512_min_epi32(a1, _mm512_loadu_si512(datos + i + 16));
+                }
+                for (; i + 16 <= n; i += 16) {
+                    a0 = _mm512_min_epi32(a0, _mm512_loadu_si512(datos + i));
+                }
+                if (i < n) {
+                    __mmask16 m = tail_mask(n - i);
+                    a1 = _mm512_mask_min_epi32(a1, m, a1, _mm512_maskz_loadu_epi32(m, datos + i));
+                }
+                return _mm512_reduce_min_epi32(_mm512_min_epi32(a0, a1));
+            }
+
+            CORE_NUMERIC_TARGET_AVX512 inline std::int64_t min(const std::int64_t* datos, std::size_t n) {
+                __m512i a0 = _mm512_set1_epi64(datos[0]), a1 = a0;
+                std::size_t i = 0;
+                for (; i + 16 <= n; i += 16) {
+                    a0 = _mm512_min_epi64(a0, _mm512_loadu_si512(datos + i));
+                    a1 = _mm512_min_epi64(a1, _mm512_loadu_si512(datos + i + 8));
+                }
+                for (; i + 8 <= n; i += 8) {
+                    a0 = _mm512_min_epi64(a0, _mm512_loadu_si512(datos + i));
+                }
+                if (i < n) {
+                    auto m = static_cast<__mmask8>(tail_mask(n - i));
+                    a1 = _mm512_mask_min_epi64(a1, m, a1, _mm512_maskz_loadu_epi64(m, datos + i));
+                }
+                alignas(64) std::int64_t carriles[8];
+                _mm512_store_si512(carriles, _mm512_min_epi64(a0, a1));
+                return portable::min(carriles, 8);
+            }
+
+            // Extremos con posicion: como en AVX2, pero greater devuelve una mascara de bits
+            // y la mezcla se hace con mask_blend (toma b en los carriles activos)
+            template <typename T>
+            struct lanes;
+
+            template <>
+            struct lanes<double> {
+                using vec = __m512d;
+                using mask = __mmask8;
+                using pos_t = std::uint64_t;
+                static constexpr std::size_t carriles = 8;
+                static CORE_NUMERIC_TARGET_AVX512 vec set1(double x) { return _mm512_set1_pd(x); }
+                static CORE_NUMERIC_TARGET_AVX512 vec load(const double* p) { return _mm512_loadu_pd(p); }
+                static CORE_NUMERIC_TARGET_AVX512 void store(double* p, vec v) { _mm512_store_pd(p, v); }
+                static CORE_NUMERIC_TARGET_AVX512 mask greater(vec a, vec b) { return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ); }
+                static CORE_NUMERIC_TARGET_AVX512 vec select(mask m, vec a, vec b) { return _mm512_mask_blend_pd(m, a, b); }
+                static CORE_NUMERIC_TARGET_AVX512 __m512i select_pos(mask m, __m512i a, __m512i b) { return _mm512_mask_blend_epi64(m, a, b); }
+                static CORE_NUMERIC_TARGET_AVX512 __m512i positions(pos_t base) { return _mm512_add_epi64(_mm512_set1_epi64(static_cast<long long>(base)), _mm512_setr_epi64(0, 1, 2, 3, 4, 5, 6, 7)); }
+                static CORE_NUMERIC_TARGET_AVX512 __m512i advance(__m512i p, pos_t paso) { return _mm512_add_epi64(p, _mm512_set1_epi64(static_cast<long long>(paso))); }
+            };
+
+            template <>
+            struct lanes<std::int64_t> {
+                using vec = __m512i;
+                using mask = __mmask8;
+                using pos_t = std::uint64_t;
+                static constexpr std::size_t carriles = 8;
+                static CORE_NUMERIC_TARGET_AVX512 vec set1(std::int64_t x) { return _mm512_set1_epi64(x); }
+                static CORE_NUMERIC_TARGET_AVX512 vec load(const std::int64_t* p) { return _mm512_loadu_si512(p); }
+                static CORE_NUMERIC_TARGET_AVX512 void store(std::int64_t* p, vec v) { _mm512_store_si512(p, v); }
+                static CORE_NUMERIC_TARGET_AVX512 mask greater(vec a, vec b) { return _mm512_cmpgt_epi64_mask(a, b); }
+                static CORE_NUMERIC_TARGET_AVX512 vec select(mask m, vec a, vec b) { return _mm512_mask_blend_epi64(m, a, b); }
+                static CORE_NUMERIC_TARGET_AVX512 __m512i select_pos(mask m, __m512i a, __m512i b) { return _mm512_mask_blend_epi64(m, a, b); }
+                static CORE_NUMERIC_TARGET_AVX512 __m512i positions(pos_t base) { return lanes<double>::positions(base); }
+                static CORE_NUMERIC_TARGET_AVX512 __m512i advance(__m512i p, pos_t paso) { return lanes<double>::advance(p, paso); }
+            };
+
+            // float e int32 llevan posiciones de 32 bits: el despacho no los manda aqui con 2^32 elementos o mas
+            template <>
+            struct lanes<float> {
+                using vec = __m512;
+                using mask = __mmask16;
+                using pos_t = std::uint32_t;
+                static constexpr std::size_t carriles = 16;
+                static CORE_NUMERIC_TARGET_AVX512 vec set1(float x) { return _mm512_set1_ps(x); }
+                static CORE_NUMERIC_TARGET_AVX512 vec load(const float* p) { return _mm512_loadu_ps(p); }
+                static CORE_NUMERIC_TARGET_AVX512 void store(float* p, vec v) { _mm512_store_ps(p, v); }
+                static CORE_NUMERIC_TARGET_AVX512 mask greater(vec a, vec b) { return _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ); }
+                static CORE_NUMERIC_TARGET_AVX512 vec select(mask m, vec a, vec b) { return _mm512_mask_blend_ps(m, a, b); }
+                static CORE_NUMERIC_TARGET_AVX512 __m512i select_pos(mask m, __m512i a, __m512i b) { return _mm512_mask_blend_epi32(m, a, b); }
+                static CORE_NUMERIC_TARGET_AVX512 __m512i positions(pos_t base) {
+                    return _mm512_add_epi32(_mm512_set1_epi32(static_cast<int>(base)),
+                                            _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+                }
+                static CORE_NUMERIC_TARGET_AVX512 __m512i advance(__m512i p, pos_t paso) { return _mm512_add_epi32(p, _mm512_set1_epi32(static_cast<int>(paso))); }
+            };
+
+            template <>
+            struct lanes<std::int32_t> {
+                using vec = __m512i;
+                using mask = __mmask16;
+                using pos_t = std::uint32_t;
+                static constexpr std::size_t carriles = 16;
+                static CORE_NUMERIC_TARGET_AVX512 vec set1(std::int32_t x) { return _mm512_set1_epi32(x); }
+                static CORE_NUMERIC_TARGET_AVX512 vec load(const std::int32_t* p) { return _mm512_loadu_si512(p); }
+                static CORE_NUMERIC_TARGET_AVX512 void store(std::int32_t* p, vec v) { _mm512_store_si512(p, v); }
+                static CORE_NUMERIC_TARGET_AVX512 mask greater(vec a, vec b) { return _mm512_cmpgt_epi32_mask(a, b); }
+                static CORE_NUMERIC_TARGET_AVX512 vec select(mask m, vec a, vec b) { return _mm512_mask_blend_epi32(m, a, b); }
+                static CORE_NUMERIC_TARGET_AVX512 __m512i select_pos(mask m, __m512i a, __m512i b) { return _mm512_mask_blend_epi32(m, a, b); }
+                static CORE_NUMERIC_TARGET_AVX512 __m512i positions(pos_t base) { return lanes<float>::positions(base); }
+                static CORE_NUMERIC_TARGET_AVX512 __m512i advance(__m512i p, pos_t paso) { return lanes<float>::advance(p, paso); }
+            };
+
+            template <bool Min, bool Max, typename T>
+            CORE_NUMERIC_TARGET_AVX512 minmax_result<T> extremes(const T* datos, std::size_t n) {
+                using L = lanes<T>;
+                constexpr std::size_t C = L::carriles;
+                auto mayor0 = L::set1(datos[0]), mayor1 = mayor0, menor0 = mayor0, menor1 = mayor0;
+                __m512i pos_mayor0 = _mm512_setzero_si512(), pos_mayor1 = pos_mayor0, pos_menor0 = pos_mayor0, pos_menor1 = pos_mayor0;
+                __m512i actual0 = L::positions(0), actual1 = L::positions(C);
+                std::size_t i = 0;
+                for (; i + 2 * C <= n; i += 2 * C) {
+                    auto x0 = L::load(datos + i);
+                    auto x1 = L::load(datos + i + C);
+                    if constexpr (Max) {
+                        auto m0 = L::greater(x0, mayor0), m1 = L::greater(x1, mayor1);
+                        mayor0 = L::select(m0, mayor0, x0);
+                        mayor1 = L::select(m1, mayor1, x1);
+                        pos_mayor0 = L::select_pos(m0, pos_mayor0, actual0);
+                        pos_mayor1 = L::select_pos(m1, pos_mayor1, actual1);
+                    }
+                    if constexpr (Min) {
+                        auto m0 = L::greater(menor0, x0), m1 = L::greater(menor1, x1);
+                        menor0 = L::select(m0, menor0, x0);
+                        menor1 = L::select(m1, menor1, x1);
+                        pos_menor0 = L::select_pos(m0, pos_menor0, actual0);
+                        pos_menor1 = L::select_pos(m1, pos_menor1, actual1);
+                    }
+                    actual0 = L::advance(actual0, 2 * C);
+                    actual1 = L::advance(actual1, 2 * C);
+                }
+                alignas(64) T valores[2 * C];
+                alignas(64) typename L::pos_t posiciones[2 * C];
+                minmax_result<T> resultado;
+                if constexpr (Max) {
+                    L::store(valores, mayor0);
+                    L::store(valores + C, mayor1);
+                    _mm512_store_si512(posiciones, pos_mayor0);
+                    _mm512_store_si512(posiciones + C, pos_mayor1);
+                    resultado.max = portable::best_lane<false>(valores, posiciones, 2 * C);
+                }
+                if constexpr (Min) {
+                    L::store(valores, menor0);
+                    L::store(valores + C, menor1);
+                    _mm512_store_si512(posiciones, pos_menor0);
+                    _mm512_store_si512(posiciones + C, pos_menor1);
+                    resultado.min = portable::best_lane<true>(valores, posiciones, 2 * C);
+                }
+                portable::extremes_tail<Min, Max>(resultado, datos, i, n);
+                return resultado;
+            }
+
+            CORE_NUMERIC_TARGET_AVX512 inline double sum_sq_dev(const double* datos, std::size_t n, double media) {
+                const __m512d m = _mm512_set1_pd(media);
+                __m512d a0 = _mm512_setzero_pd(), a1 = a0, a2 = a0, a3 = a0;
+                std::size_t i = 0;
+                for (; i + 32 <= n; i += 32) {
+                    __m512d d0 = _mm512_sub_pd(_mm512_loadu_pd(datos + i), m);
+                    __m512d d1 = _mm512_sub_pd(_mm512_loadu_pd(datos + i + 8), m);
+                    __m512d d2 = _mm512_sub_pd(_mm512_loadu_pd(datos + i + 16), m);
+                    __m512d d3 = _mm512_sub_pd(_mm512_loadu_pd(datos + i + 24), m);
+                    a0 = _mm512_fmadd_pd(d0, d0, a0);
+                    a1 = _mm512_fmadd_pd(d1, d1, a1);
+                    a2 = _mm512_fmadd_pd(d2, d2, a2);
+                    a3 = _mm512_fmadd_pd(d3, d3, a3);
+                }
+                for (; i + 8 <= n; i += 8) {
+                    __m512d d = _mm512_sub_pd(_mm512_loadu_pd(datos + i), m);
+                    a0 = _mm512_fmadd_pd(d, d, a0);
+                }
+                if (i < n) {
+                    // Los carriles fuera de la mascara quedan en 0 y no aportan
+                    auto mask = static_cast<__mmask8>(tail_mask(n - i));
+                    __m512d d = _mm512_maskz_sub_pd(mask, _mm512_maskz_loadu_pd(mask, datos + i), m);
+                    a1 = _mm512_fmadd_pd(d, d, a1);
+                }
+                return hsum(_mm512_add_pd(_mm512_add_pd(a0, a1), _mm512_add_pd(a2, a3)));
+            }
+
+            CORE_NUMERIC_TARGET_AVX512 inline float sum_sq_dev(const float* datos, std::size_t n, float media) {
+                const __m512 m = _mm512_set1_ps(media);
+                __m512 a0 = _mm512_setzero_ps(), a1 = a0, a2 = a0, a3 = a0;
+                std::size_t i = 0;
+                for (; i + 64 <= n; i += 64) {
+                    __m512 d0 = _mm512_sub_ps(_mm512_loadu_ps(datos + i), m);
+                    __m512 d1 = _mm512_sub_ps(_mm512_loadu_ps(datos + i + 16), m);
+                    __m512 d2 = _mm512_sub_ps(_mm512_loadu_ps(datos + i + 32), m);
+                    __m512 d3 = _mm512_sub_ps(_mm512_loadu_ps(datos + i + 48), m);
+                    a0 = _mm512_fmadd_ps(d0, d0, a0);
+                    a1 = _mm512_fmadd_ps(d1, d1, a1);
+                    a2 = _mm512_fmadd_ps(d2, d2, a2);
+                    a3 = _mm512_fmadd_ps(d3, d3, a3);
+                }
+                for (; i + 16 <= n; i += 16) {
+                    __m512 d = _mm512_sub_ps(_mm512_loadu_ps(datos + i), m);
+                    a0 = _mm512_fmadd_ps(d, d, a0);
+                }
+                if (i < n) {
+                    __mmask16 mask = tail_mask(n - i);
+                    __m512 d = _mm512_maskz_sub_ps(mask, _mm512_maskz_loadu_ps(mask, datos + i), m);
+                    a1 = _mm512_fmadd_ps(d, d, a1);
+                }
+                return hsum(_mm512_add_ps(_mm512_add_ps(a0, a1), _mm512_add_ps(a2, a3)));
+            }
+
+            template <typename T, typename A, typename Op, typename Func>
+            CORE_NUMERIC_TARGET_AVX512 A transform_fold(const T* datos, std::size_t n, A inicial, Op& op, Func& funcion) {
+                return portable::transform_fold(datos, n, inicial, op, funcion);
+            }
+
+            template <typename T, typename U, typename A, typename Op, typename Func>
+            CORE_NUMERIC_TARGET_AVX512 A transform_fold(const T* a, const U* b, std::size_t n, A inicial, Op& op, Func& funcion) {
+                return portable::transform_fold(a, b, n, inicial, op, funcion);
+            }
+
+            CORE_NUMERIC_TARGET_AVX512 inline double dot(const double* a, const double* b, std::size_t n) {
+                __m512d a0 = _mm512_setzero_pd(), a1 = a0, a2 = a0, a3 = a0;
+                std::size_t i = 0;
+                for (; i + 32 <= n; i += 32) {
+                    a0 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i), a0);
+                    a1 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i + 8), _mm512_loadu_pd(b + i + 8), a1);
+                    a2 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i + 16), _mm512_loadu_pd(b + i + 16), a2);
+                    a3 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i + 24), _mm512_loadu_pd(b + i + 24), a3);
+                }
+                for (; i + 8 <= n; i += 8) {
+                    a0 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i), a0);
+                }
+                if (i < n) {
+                    // Los carriles fuera de la mascara se cargan como 0 y no aportan
+                    auto mask = static_cast<__mmask8>(tail_mask(n - i));
+                    a1 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(mask, a + i), _mm512_maskz_loadu_pd(mask, b + i), a1);
+                }
+                return hsum(_mm512_add_pd(_mm512_add_pd(a0, a1), _mm512_add_pd(a2, a3)));
+            }
+
+            CORE_NUMERIC_TARGET_AVX512 inline float dot(const float* a, const float* b, std::size_t n) {
+                __m512 a0 = _mm512_setzero_ps(), a1 = a0, a2 = a0, a3 = a0;
+                std::size_t i = 0;
+                for (; i + 64 <= n; i += 64) {
+                    a0 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i), a0);
+                    a1 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i + 16), _mm512_loadu_ps(b + i + 16), a1);
+                    a2 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i + 32), _mm512_loadu_ps(b + i + 32), a2);
+                    a3 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i + 48), _mm512_loadu_ps(b + i + 48), a3);
+                }
+                for (; i + 16 <= n; i += 16) {
+                    a0 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i), a0);
+                }
+                if (i < n) {
+                    __mmask16 mask = tail_mask(n - i);
+                    a1 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(mask, a + i), _mm512_maskz_loadu_ps(mask, b + i), a1);
+                }
+                return hsum(_mm512_add_ps(_mm512_add_ps(a0, a1), _mm512_add_ps(a2, a3)));
+            }
+
+            CORE_NUMERIC_TARGET_AVX512 inline void two_sum(__m512d& s, __m512d& c, __m512d x) {
+                __m512d t = _mm512_add_pd(s, x);
+                __m512d z = _mm512_sub_pd(t, s);
+                __m512d e = _mm512_add_pd(_mm512_sub_pd(s, _mm512_sub_pd(t, z)), _mm512_sub_pd(x, z));
+                c = _mm512_add_pd(c, e);
+                s = t;
+            }
+
+            CORE_NUMERIC_TARGET_AVX512 inline void two_sum(__m512& s, __m512& c, __m512 x) {
+                __m512 t = _mm512_add_ps(s, x);
+                __m512 z = _mm512_sub_ps(t, s);
+                __m512 e = _mm512_add_ps(_mm512_sub_ps(s, _mm512_sub_ps(t, z)), _mm512_sub_ps(x, z));
+                c = _mm512_add_ps(c, e);
+                s = t;
+            }
+
+            // Suma compensada. La cola entra con carga enmascarada: los ceros no alteran ni la suma ni el error
+            CORE_NUMERIC_TARGET_AVX512 inline double kbn_sum(const double* datos, std::size_t n) {
+                __m512d s0 = _mm512_setzero_pd(), c0 = s0, s1 = s0, c1 = s0, s2 = s0, c2 = s0, s3 = s0, c3 = s0;
+                std::size_t i = 0;
+                for (; i + 32 <= n; i += 32) {
+                    two_sum(s0, c0, _mm512_loadu_pd(datos + i));
+                    two_sum(s1, c1, _mm512_loadu_pd(datos + i + 8));
+                    two_sum(s2, c2, _mm512_loadu_pd(datos + i + 16));
+                    two_sum(s3, c3, _mm512_loadu_pd(datos + i + 24));
+                }
+                for (; i + 8 <= n; i += 8) {
+                    two_sum(s0, c0, _mm512_loadu_pd(datos + i));
+                }
+                if (i < n) {
+                    two_sum(s1, c1, _mm512_maskz_loadu_pd(static_cast<__mmask8>(tail_mask(n - i)), datos + i));
+                }
+                alignas(64) double s[32];
+                alignas(64) double c[32];
+                _mm512_store_pd(s, s0);
+                _mm512_store_pd(s + 8, s1);
+                _mm512_store_pd(s + 16, s2);
+                _mm512_store_pd(s + 24, s3);
+                _mm512_store_pd(c, c0);
+                _mm512_store_pd(c + 8, c1);
+                _mm512_store_pd(c + 16, c2);
+                _mm512_store_pd(c + 24, c3);
+                return portable::kbn_finish(s, c, 32, datos, 0);
+            }
+
+            CORE_NUMERIC_TARGET_AVX512 inline float kbn_sum(const float* datos, std::size_t n) {
+                __m512 s0 = _mm512_setzero_ps(), c0 = s0, s1 = s0, c1 = s0, s2 = s0, c2 = s0, s3 = s0, c3 = s0;
+                std::size_t i = 0;
+                for (; i + 64 <= n; i += 64) {
+                    two_sum(s0, c0, _mm512_loadu_ps(datos + i));
+                    two_sum(s1, c1, _mm512_loadu_ps(datos + i + 16));
+                    two_sum(s2, c2, _mm512_loadu_ps(datos + i + 32));
+                    two_sum(s3, c3, _mm512_loadu_ps(datos + i + 48));
+                }
+                for (; i + 16 <= n; i += 16) {
+                    two_sum(s0, c0, _mm512_loadu_ps(datos + i));
+                }
+                if (i < n) {
+                    two_sum(s1, c1, _mm512_maskz_loadu_ps(tail_mask(n - i), datos + i));
+                }
+                alignas(64) float s[64];
+                alignas(64) float c[64];
+                _mm512_store_ps(s, s0);
+                _mm512_store_ps(s + 16, s1);
+                _mm512_store_ps(s + 32, s2);
+                _mm512_store_ps(s + 48, s3);
+                _mm512_store_ps(c, c0);
+                _mm512_store_ps(c + 16, c1);
+                _mm512_store_ps(c + 32, c2);
+                _mm512_store_ps(c + 48, c3);
+                return portable::kbn_finish(s, c, 64, datos, 0);
+            }
+
+            CORE_NUMERIC_TARGET_AVX512 inline __m512i load_widen(const std::int32_t* p) {
+                return _mm512_cvtepi32_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)));
+            }
+
+            CORE_NUMERIC_TARGET_AVX512 inline std::int64_t wide_sum(const std::int32_t* datos, std::size_t n) {
+                __m512i a0 = _mm512_setzero_si512(), a1 = a0, a2 = a0, a3 = a0;
+                std::size_t i = 0;
+                for (; i + 32 <= n; i += 32) {
+                    a0 = _mm512_add_epi64(a0, load_widen(datos + i));
+                    a1 = _mm512_add_epi64(a1, load_widen(datos + i + 8));
+                    a2 = _mm512_add_epi64(a2, load_widen(datos + i + 16));
+                    a3 = _mm512_add_epi64(a3, load_widen(datos + i + 24));
+                }
+                for (; i + 8 <= n; i += 8) {
+                    a0 = _mm512_add_epi64(a0, load_widen(datos + i));
+                }
+                std::int64_t resultado = hsum_epi64(_mm512_add_epi64(_mm512_add_epi64(a0, a1), _mm512_add_epi64(a2, a3)));
+                for (; i < n; ++i) {
+                    resultado += datos[i];
+                }
+                return resultado;
+            }
+
+#if CORE_NUMERIC_HAS_INT128
+            // Igual que en AVX2, pero AVX-512 compara sin signo directamente y devuelve una mascara
+            CORE_NUMERIC_TARGET_AVX512 inline void add_wide(__m512i& bajo, __m512i& alto, __m512i x, __m512i extension) {
+                __m512i suma = _mm512_add_epi64(bajo, x);
+                __mmask8 acarreo = _mm512_cmplt_epu64_mask(suma, x);
+                alto = _mm512_add_epi64(alto, extension);
+                alto = _mm512_mask_add_epi64(alto, acarreo, alto, _mm512_set1_epi64(1));
+                bajo = suma;
+            }
+
+            CORE_NUMERIC_TARGET_AVX512 inline int128 wide_sum(const std::int64_t* datos, std::size_t n) {
+                const __m512i cero = _mm512_setzero_si512();
+                __m512i b0 = cero, h0 = cero, b1 = cero, h1 = cero;
+                std::size_t i = 0;
+                for (; i + 16 <= n; i += 16) {
+                    __m512i x0 = _mm512_loadu_si512(datos + i);
+                    __m512i x1 = _mm512_loadu_si512(datos + i + 8);
+                    add_wide(b0, h0, x0, _mm512_srai_epi64(x0, 63));
+                    add_wide(b1, h1, x1, _mm512_srai_epi64(x1, 63));
+                }
+                if (i + 8 <= n) {
+                    __m512i x = _mm512_loadu_si512(datos + i);
+                    add_wide(b0, h0, x, _mm512_srai_epi64(x, 63));
+                    i += 8;
+                }
+                if (i < n) {
+                    __m512i x = _mm512_maskz_loadu_epi64(static_cast<__mmask8>(tail_mask(n - i)), datos + i);
+                    add_wide(b1, h1, x, _mm512_srai_epi64(x, 63));
+                }
+                alignas(64) std::uint64_t bajo[16];
+                alignas(64) std::uint64_t alto[16];
+                _mm512_store_si512(bajo, b0);
+                _mm512_store_si512(bajo + 8, b1);
+                _mm512_store_si512(alto, h0);
+                _mm512_store_si512(alto + 8, h1);
+                return static_cast<int128>(portable::join_wide(bajo, alto, 16));
+            }
+
+            CORE_NUMERIC_TARGET_AVX512 inline uint128 sum_squares(const std::int32_t* datos, std::size_t n) {
+                const __m512i cero = _mm512_setzero_si512();
+                __m512i b0 = cero, h0 = cero, b1 = cero, h1 = cero;
+                std::size_t i = 0;
+                for (; i + 16 <= n; i += 16) {
+                    __m512i x = _mm512_loadu_si512(datos + i);
+                    __m512i impares = _mm512_srli_epi64(x, 32);
+                    add_wide(b0, h0, _mm512_mul_epi32(x, x), cero);
+                    add_wide(b1, h1, _mm512_mul_epi32(impares, impares), cero);
+                }
+                if (i < n) {
+                    __m512i x = _mm512_maskz_loadu_epi32(tail_mask(n - i), datos + i);
+                    __m512i impares = _mm512_srli_epi64(x, 32);
+                    add_wide(b0, h0, _mm512_mul_epi32(x, x), cero);
+                    add_wide(b1, h1, _mm512_mul_epi32(impares, impares), cero);
+                }
+                alignas(64) std::uint64_t bajo[16];
+                alignas(64) std::uint64_t alto[16];
+                _mm512_store_si512(bajo, b0);
+                _mm512_store_si512(bajo + 8, b1);
+                _mm512_store_si512(alto, h0);
+                _mm512_store_si512(alto + 8, h1);
+                return portable::join_wide(bajo, alto, 16);
+            }
+#endif
+        } // namespace avx512
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#endif
+
+        // Puntos de despacho: eligen el kernel segun el ISA activo en cada llamada
+        template <SimdSummable T>
+        T sum_kernel(const T* datos, std::size_t n) {
+            switch (kernel_isa()) {
+#if CORE_NUMERIC_X86
+                case isa::avx512: return avx512::sum(datos, n);
+                case isa::avx2: return avx2::sum(datos, n);
+                case isa::sse42: return sse42::sum(datos, n);
+#endif
+                default: return portable::sum(datos, n);
+            }
+        }
+
+        // Requiere n >= 1
+        template <SimdSummable T>
+        T max_kernel(const T* datos, std::size_t n) {
+            switch (kernel_isa()) {
+#if CORE_NUMERIC_X86
+                case isa::avx512: return avx512::max(datos, n);
+                case isa::avx2: return avx2::max(datos, n);
+                case isa::sse42: return sse42::max(datos, n);
+#endif
+                default: return portable::max(datos, n);
+            }
+        }
+
+        // Requiere n >= 1
+        template <SimdSummable T>
+        T min_kernel(const T* datos, std::size_t n) {
+            switch (kernel_isa()) {
+#if CORE_NUMERIC_X86
+                case isa::avx512: return avx512::min(datos, n);
+                case isa::avx2: return avx2::min(datos, n);
+                case isa::sse42: return sse42::min(datos, n);
+#endif
+                default: return portable::min(datos, n);
+            }
+        }
+
+        // Requiere n >= 1. float e int32 llevan las posiciones en carriles de 32 bits:
+        // con 2^32 elementos o mas se usa el kernel portable, que las lleva en size_t
+        template <bool Min, bool Max, SimdSummable T>
+        minmax_result<T> extremes_kernel(const T* datos, std::size_t n) {
+            if constexpr (sizeof(T) == 4) {
+                if (n > std::numeric_limits<std::uint32_t>::max() - 64) return portable::extremes<Min, Max>(datos, n);
+            }
+            switch (kernel_isa()) {
+#if CORE_NUMERIC_X86
+                case isa::avx512: return avx512::extremes<Min, Max>(datos, n);
+                case isa::avx2: return avx2::extremes<Min, Max>(datos, n);
+                case isa::sse42: return sse42::extremes<Min, Max>(datos, n);
+#endif
+                default: return portable::extremes<Min, Max>(datos, n);
+            }
+        }
+
+        template <std::floating_point T>
+        T sum_sq_dev_kernel(const T* datos, std::size_t n, T media) {
+            switch (kernel_isa()) {
+#if CORE_NUMERIC_X86
+                case isa::avx512: return avx512::sum_sq_dev(datos, n, media);
+                case isa::avx2: return avx2::sum_sq_dev(datos, n, media);
+                case isa::sse42: return sse42::sum_sq_dev(datos, n, media);
+#endif
+                default: return portable::sum_sq_dev(datos, n, media);
+            }
+        }
+
+        template <typename T, typename A, typename Op, typename Func>
+        A transform_fold_kernel(const T* datos, std::size_t n, A inicial, Op& op, Func& funcion) {
+            switch (kernel_isa()) {
+#if CORE_NUMERIC_X86
+                case isa::avx512: return avx512::transform_fold(datos, n, inicial, op, funcion);
+                case isa::avx2: return avx2::transform_fold(datos, n, inicial, op, funcion);
+                case isa::sse42: return sse42::transform_fold(datos, n, inicial, op, funcion);
+#endif
+                default: return portable::transform_fold(datos, n, inicial, op, funcion);
+            }
+        }
+
+        template <typename T, typename U, typename A, typename Op, typename Func>
+        A transform_fold_kernel(const T* a, const U* b, std::size_t n, A inicial, Op& op, Func& funcion) {
+            switch (kernel_isa()) {
+#if CORE_NUMERIC_X86
+                case isa::avx512: return avx512::transform_fold(a, b, n, inicial, op, funcion);
+                case isa::avx2: return avx2::transform_fold(a, b, n, inicial, op, funcion);
+                case isa::sse42: return sse42::transform_fold(a, b, n, inicial, op, funcion);
+#endif
+                default: return portable::transform_fold(a, b, n, inicial, op, funcion);
+            }
+        }
+
+        template <std::floating_point T>
+        T dot_kernel(const T* a, const T* b, std::size_t n) {
+            switch (kernel_isa()) {
+#if CORE_NUMERIC_X86
+                case isa::avx512: return avx512::dot(a, b, n);
+                case isa::avx2: return avx2::dot(a, b, n);
+                case isa::sse42: return sse42::dot(a, b, n);
+#endif
+                default: return portable::dot(a, b, n);
+            }
+        }
+
+        template <std::floating_point T>
+        T kbn_sum_kernel(const T* datos, std::size_t n) {
+            switch (kernel_isa()) {
+#if CORE_NUMERIC_X86
+                case isa::avx512: return avx512::kbn_sum(datos, n);
+                case isa::avx2: return avx2::kbn_sum(datos, n);
+                case isa::sse42: return sse42::kbn_sum(datos, n);
+#endif
+                default: return portable::kbn_sum(datos, n);
+            }
+        }
+
+        // Enteros con kernel de suma ensanchada: int32 -> int64 e int64 -> int128
+        template <typename T>
+        concept WideSummable = std::same_as<T, std::int32_t>
+                            || (std::same_as<T, std::int64_t> && CORE_NUMERIC_HAS_INT128 != 0);
+
+        template <WideSummable T>
+        accumulation_t<T> wide_sum_kernel(const T* datos, std::size_t n) {
+            switch (kernel_isa()) {
+#if CORE_NUMERIC_X86
+                case isa::avx512: return avx512::wide_sum(datos, n);
+                case isa::avx2: return avx2::wide_sum(datos, n);
+                case isa::sse42: return sse42::wide_sum(datos, n);
+#endif
+                default: return portable::wide_sum(datos, n);
+            }
+        }
+
+        // Los cuadrados de int64 necesitan productos de 128 bits, que no existen en SIMD:
+        // solo int32 tiene kernel vectorial, el resto usa el bucle portable
+        template <std::integral T>
+        square_sum_t sum_squares_kernel(const T* datos, std::size_t n) {
+#if CORE_NUMERIC_X86 && CORE_NUMERIC_HAS_INT128
+            if constexpr (std::same_as<T, std::int32_t>) {
+                switch (kernel_isa()) {
+                    case isa::avx512: return avx512::sum_squares(datos, n);
+                    case isa::avx2: return avx2::sum_squares(datos, n);
+                    case isa::sse42: return sse42::sum_squares(datos, n);
+                    default: break;
+                }
+            }
+#endif
+            return portable::sum_squares(datos, n);
+        }
+
+        // Hojas de la suma por parejas: se suman con el kernel SIMD normal,
+        // que ya reparte cada hoja entre varios acumuladores
+        inline constexpr std::size_t hoja_pairwise = 512;
+
+        // Suma por parejas (cascada): divide a la mitad hasta llegar a hojas de hoja_pairwise elementos.
+        // El error crece con log(n) en vez de con n, y el costo extra es una llamada cada 512 elementos
+        template <SimdSummable T>
+        T pairwise_sum_kernel(const T* datos, std::size_t n) {
+            if (n <= hoja_pairwise) return sum_kernel(datos, n);
+            std::size_t mitad = (n / 2 + hoja_pairwise - 1) / hoja_pairwise * hoja_pairwise;
+            return pairwise_sum_kernel(datos, mitad) + pairwise_sum_kernel(datos + mitad, n - mitad);
+        }
+
+        // Tamaño de bloque que cabe holgado en la cache L1 (16 KiB)
+        template <typename T>
+        inline constexpr std::size_t bloque_l1 = 16384 / sizeof(T);
+
+        // Tipos para los que se puede usar Welford: ademas de Addable y Divisible necesitan - y *
+        template <typename T>
+        concept Welfordable = Addable<T> && Divisible<T> && requires (T a, T b) {
+            { a - b } -> std::same_as<T>;
+            { a * b } -> std::same_as<T>;
+        };
+
+        // Estado de la varianza en una pasada: cantidad, media y M2 (suma de cuadrados de las desviaciones)
+        template <typename T>
+        struct moments {
+            std::size_t n = 0;
+            T media{};
+            T m2{};
+
+            // Welford: agrega un elemento. Solo usa +, -, * y la division por size_t de Divisible
+            constexpr void push(const T& x) {
+                ++n;
+                T delta = x - media;
+                media = media + delta / n;
+                m2 = m2 + delta * (x - media);
+            }
+
+            // Chan: combina con el estado de otro grupo de datos
+            constexpr void merge(const moments& otro) requires std::floating_point<T> {
+                if (otro.n == 0) return;
+                if (n == 0) {
+                    *this = otro;
+                    return;
+                }
+                const std::size_t total = n + otro.n;
+                const T delta = otro.media - media;
+                const T peso = static_cast<T>(otro.n) / static_cast<T>(total);
+                media = media + delta * peso;
+                m2 = m2 + otro.m2 + delta * delta * static_cast<T>(n) * peso;
+                n = total;
+            }
+
+            // Chan por bloques: la media y M2 del bloque salen de los kernels SIMD.
+            // El bloque se lee dos veces pero la segunda lectura viene de L1, asi que
+            // la memoria principal se recorre una sola vez. Devuelve la suma del bloque
+            T push_block(const T* datos, std::size_t cantidad) requires SimdSummable<T> && std::floating_point<T> {
+                if (cantidad == 0) return T{};
+                moments bloque;
+                bloque.n = cantidad;
+                T suma = sum_kernel(datos, cantidad);
+                bloque.media = suma / static_cast<T>(cantidad);
+                bloque.m2 = sum_sq_dev_kernel(datos, cantidad, bloque.media);
+                merge(bloque);
+                return suma;
+            }
+        };
+
+        // Media a partir de la suma. Los enteros dividen en su tipo de acumulacion (con signo si T lo tiene)
+        // y la media truncada siempre entra en T
+        template <typename T, typename A>
+        constexpr auto mean_of_sum(const A& suma, std::size_t n) {
+            if constexpr (std::is_integral_v<T>) {
+                if (n == 0) return T{};
+                return static_cast<T>(suma / static_cast<A>(n));
+            } else {
+                using R = decltype(suma / n);
+                if (n == 0) return R{};
+                return suma / n;
+            }
+        }
+
+        // Parte entera de la media q = trunc(S / n), el resto r = S - q*n y P = sum((x - q)^2) = Q - n*q^2 - 2*q*r.
+        // P se calcula modulo 2^128: es exacto siempre que su valor real entre en 128 bits, aunque Q haya dado la vuelta.
+        // Ademas M2 = P - r^2 / n
+        template <std::integral T>
+        struct integer_center {
+            square_sum_t p = 0;
+            square_sum_t r_abs = 0;
+
+            constexpr integer_center(std::size_t n, accumulation_t<T> suma, square_sum_t cuadrados) {
+                using A = accumulation_t<T>;
+                using Q = square_sum_t;
+                A q = suma / static_cast<A>(n);
+                A r = suma - q * static_cast<A>(n);
+                p = cuadrados - static_cast<Q>(n) * static_cast<Q>(q) * static_cast<Q>(q)
+                  - Q{2} * static_cast<Q>(q) * static_cast<Q>(r);
+                if constexpr (std::is_signed_v<A>) {
+                    r_abs = static_cast<Q>(r < 0 ? -r : r);
+                } else {
+                    r_abs = static_cast<Q>(r);
+                }
+            }
+        };
+
+        // Varianza exacta de enteros, truncada: floor((P*n - r^2) / n^2).
+        // Con P = a*n + b queda a - 1 si b*n < r^2 y a si no, asi nunca se multiplica P por n
+        template <std::integral T>
+        constexpr variance_type<T> integer_variance(std::size_t n, accumulation_t<T> suma, square_sum_t cuadrados) {
+            if (n == 0) return {};
+            integer_center<T> centro(n, suma, cuadrados);
+            const square_sum_t cantidad = n;
+            square_sum_t a = centro.p / cantidad;
+            square_sum_t b = centro.p % cantidad;
+            if (b * cantidad < centro.r_abs * centro.r_abs) --a;
+            return static_cast<variance_type<T>>(a);
+        }
+
+        // M2 exacto de enteros, truncado: P - ceil(r^2 / n)
+        template <std::integral T>
+        constexpr square_sum_t integer_m2(std::size_t n, accumulation_t<T> suma, square_sum_t cuadrados) {
+            if (n == 0) return 0;
+            integer_center<T> centro(n, suma, cuadrados);
+            const square_sum_t cantidad = n;
+            return centro.p - (centro.r_abs * centro.r_abs + cantidad - 1) / cantidad;
+        }
+    } // namespace detail
+
+    // Etiquetas para elegir el algoritmo de variance
+    struct two_pass_t { explicit two_pass_t() = default; };     // media primero, desviaciones despues
+    struct one_pass_t { explicit one_pass_t() = default; };     // Welford/Chan, una sola lectura de los datos
+    inline constexpr two_pass_t two_pass{};
+    inline constexpr one_pass_t one_pass{};
+
+    // Etiquetas para elegir como suma sum (y mean). Se resuelven en compilacion, sin costo en ejecucion
+    struct fast_t { explicit fast_t() = default; };             // acumuladores SIMD en paralelo, el mas rapido
+    struct pairwise_t { explicit pairwise_t() = default; };     // por parejas (cascada), error O(log n)
+    struct kbn_t { explicit kbn_t() = default; };               // compensada de Kahan-Babuska-Neumaier, error O(1)
+    inline constexpr fast_t fast{};
+    inline constexpr pairwise_t pairwise{};
+    inline constexpr kbn_t kbn{};
+
+    template <typename S>
+    concept SummationPolicy = std::same_as<S, fast_t> || std::same_as<S, pairwise_t> || std::same_as<S, kbn_t>;
+
+
+    // ALGORITMOS GENERICOS:
+
+    
+
+    // Todos los algoritmos de esta seccion son constexpr: en evaluacion constante (por ejemplo sobre un
+    // std::array constexpr) los kernels SIMD no se pueden usar y se recorre el contenedor con el bucle generico.
+    // En ejecucion se sigue usando el kernel del ISA activo. El resultado en compilacion puede diferir
+    // en el ultimo bit del de ejecucion, porque el kernel suma en otro orden
+
+    // Función sum
+    // Funcion auxiliar implementada para ser reutilizada en mean y variance
+    // Si el contenedor es contiguo y de un tipo nativo (float, double, int32, int64) usa un kernel SIMD,
+    // en otro caso (por ejemplo Vector3D) se queda con el bucle generico basado en Addable.
+    // El resultado es del tipo de acumulacion: los enteros se suman ensanchados (int32 en int64,
+    // int64 en int128) y no desbordan. sum<Acc>(c) elige otro tipo, por ejemplo sum<std::int32_t>
+    // para la suma modular en el mismo tipo
+    template <typename Acc = void, Iterable C>       //Tiene que ser de tipo iterable
+    requires Addable<std::ranges::range_value_t<C>>    //El tipo de dato contenido debe ser sumable
+    constexpr auto sum(C&& contenedor) {
+        CORE_NUMERIC_INSTRUMENT_SCOPE(sum, contenedor);
+        using T = std::ranges::range_value_t<C>;
+        using A = std::conditional_t<std::is_void_v<Acc>, accumulation_t<T>, Acc>;
+
+        if constexpr (detail::SimdRange<C>) {
+            if (!std::is_constant_evaluated()) {
+                const T* datos = std::ranges::data(contenedor);
+                const std::size_t n = std::ranges::size(contenedor);
+                if constexpr (std::same_as<A, T>) {
+                    return detail::sum_kernel<T>(datos, n);
+                } else if constexpr (detail::WideSummable<T> && std::same_as<A, accumulation_t<T>>) {
+                    return detail::wide_sum_kernel<T>(datos, n);
+                }
+            }
+        }
+
+        A resultado{}; // Inicializa en 0 o constructor por defecto
+
+        for (const auto& valor : contenedor) {
+            resultado = resultado + static_cast<A>(valor);
+        }
+        return resultado;
+    }
+
+    namespace detail {
+
+        // Suma por parejas para contenedores sin memoria contigua (listas, Vector3D...), en una sola pasada.
+        // Cada hoja se suma de izquierda a derecha y su resultado entra en un contador binario:
+        // el nivel k guarda la suma de 2^k hojas, asi cada valor participa en O(log n) sumas.
+        // Deja en cantidad el numero de elementos, para que mean no tenga que recorrer el rango otra vez
+        template <typename C>
+        constexpr auto cascade_sum(C&& contenedor, std::size_t& cantidad) {
+            using T = std::ranges::range_value_t<C>;
+            constexpr std::size_t hoja = 64;
+            T niveles[64] = {};
+            bool ocupado[64] = {};
+
+            T parcial{};
+            std::size_t en_hoja = 0;
+            cantidad = 0;
+            auto subir = [&](T valor) {
+                std::size_t k = 0;
+                while (ocupado[k]) {
+                    valor = niveles[k] + valor;
+                    ocupado[k] = false;
+                    ++k;
+                }
+                niveles[k] = valor;
+                ocupado[k] = true;
+            };
+            for (const auto& valor : contenedor) {
+                parcial = parcial + valor;
+                ++cantidad;
+                if (++en_hoja == hoja) {
+                    subir(parcial);
+                    parcial = T{};
+                    en_hoja = 0;
+                }
+            }
+
+            // Se combinan los niveles restantes del menor al mayor, igual que si se completara el arbol
+            T resultado = parcial;
+            for (std::size_t k = 0; k < 64; ++k) {
+                if (ocupado[k]) resultado = niveles[k] + resultado;
+            }
+            return resultado;
+        }
+
+        // Valor absoluto utilizable en evaluacion constante (std::abs no es constexpr hasta C++23)
+        template <typename T>
+        constexpr T magnitud(T x) {
+            return x < T{} ? -x : x;
+        }
+
+        // Suma compensada de Neumaier elemento a elemento, para contenedores no contiguos.
+        // Como cascade_sum, deja en cantidad el numero de elementos
+        template <typename C>
+        constexpr auto neumaier_sum(C&& contenedor, std::size_t& cantidad) {
+            using T = std::ranges::range_value_t<C>;
+            T suma{};
+            T compensacion{};
+            cantidad = 0;
+            for (const auto& x : contenedor) {
+                ++cantidad;
+                T t = suma + x;
+                if (magnitud(suma) >= magnitud(x)) {
+                    compensacion += (suma - t) + x;
+                } else {
+                    compensacion += (x - t) + suma;
+                }
+                suma = t;
+            }
+            return suma + compensacion;
+        }
+    } // namespace detail
+
+    // sum con modo de suma explicito: sum(v, core_numeric::kbn).
+    // En enteros la suma ya es exacta (modular), asi que los tres modos son la suma rapida.
+    // kbn solo aplica a tipos aritmeticos porque necesita comparar magnitudes
+    template <Iterable C, SummationPolicy S>
+    requires Addable<std::ranges::range_value_t<C>>
+          && (!std::same_as<S, kbn_t> || std::is_arithmetic_v<std::ranges::range_value_t<C>>)
+    constexpr auto sum(C&& contenedor, S) {
+        CORE_NUMERIC_INSTRUMENT_SCOPE(sum, contenedor);
+        using T = std::ranges::range_value_t<C>;
+
+        if constexpr (std::same_as<S, fast_t> || std::is_integral_v<T>) {
+            return sum(contenedor);
+        } else if constexpr (std::same_as<S, pairwise_t>) {
+            if constexpr (detail::SimdRange<C>) {
+                if (!std::is_constant_evaluated()) {
+                    return detail::pairwise_sum_kernel<T>(std::ranges::data(contenedor), std::ranges::size(contenedor));
+                }
+            }
+            std::size_t cantidad = 0;
+            return detail::cascade_sum(contenedor, cantidad);
+        } else {
+            if constexpr (detail::SimdRange<C>) {
+                if (!std::is_constant_evaluated()) {
+                    return detail::kbn_sum_kernel<T>(std::ranges::data(contenedor), std::ranges::size(contenedor));
+                }
+            }
+            std::size_t cantidad = 0;
+            return detail::neumaier_sum(contenedor, cantidad);
+        }
+    }
+
+    namespace detail {
+
+        // Suma ensanchada (como sum) que cuenta los elementos mientras suma, en una sola pasada
+        template <typename C>
+        constexpr auto counted_sum(C&& contenedor, std::size_t& cantidad) {
+            using A = accumulation_t<std::ranges::range_value_t<C>>;
+            A resultado{};
+            cantidad = 0;
+            for (const auto& valor : contenedor) {
+                resultado = resultado + static_cast<A>(valor);
+                ++cantidad;
+            }
+            return resultado;
+        }
+    } // namespace detail
+
+    // Algoritmo mean (promedio)
+    // Reutiliza sum y requiere concept Divisible (o ser entero: la suma ensanchada se divide
+    // en su propio tipo y la media truncada se devuelve como T).
+    // Los rangos sin tamaño (istream_view, generadores, vistas filtradas) se cuentan mientras se suman:
+    // se consumen una sola vez y con memoria constante
+    template <Iterable C>
+    requires detail::Averageable<std::ranges::range_value_t<C>> && Addable<std::ranges::range_value_t<C>>
+    constexpr auto mean(C&& contenedor) {
+        CORE_NUMERIC_INSTRUMENT_SCOPE(mean, contenedor);
+        using T = std::ranges::range_value_t<C>;
+        if constexpr (std::ranges::sized_range<C>) {
+            // Reutilizamos sum como pide el PDF
+            auto suma_total = sum(contenedor);
+            std::size_t n = std::ranges::size(contenedor);
+
+            // Division por n (con el caso vacio resuelto adentro)
+            return detail::mean_of_sum<T>(suma_total, n);
+        } else {
+            std::size_t n = 0;
+            auto suma_total = detail::counted_sum(contenedor, n);
+            return detail::mean_of_sum<T>(suma_total, n);
+        }
+    }
+
+    // mean con modo de suma explicito: mean(v, core_numeric::pairwise).
+    // Sin tamaño conocido, cada modo cuenta en su propio recorrido
+    template <Iterable C, SummationPolicy S>
+    requires detail::Averageable<std::ranges::range_value_t<C>> && Addable<std::ranges::range_value_t<C>>
+          && requires (C& c, S modo) { sum(c, modo); }
+    constexpr auto mean(C&& contenedor, S modo) {
+        CORE_NUMERIC_INSTRUMENT_SCOPE(mean, contenedor);
+        using T = std::ranges::range_value_t<C>;
+        if constexpr (std::ranges::sized_range<C>) {
+            auto suma_total = sum(contenedor, modo);
+            return detail::mean_of_sum<T>(suma_total, std::ranges::size(contenedor));
+        } else {
+            std::size_t n = 0;
+            if constexpr (std::same_as<S, fast_t> || std::is_integral_v<T>) {
+                auto suma_total = detail::counted_sum(contenedor, n);
+                return detail::mean_of_sum<T>(suma_total, n);
+            } else if constexpr (std::same_as<S, pairwise_t>) {
+                auto suma_total = detail::cascade_sum(contenedor, n);
+                return detail::mean_of_sum<T>(suma_total, n);
+            } else {
+                auto suma_total = detail::neumaier_sum(contenedor, n);
+                return detail::mean_of_sum<T>(suma_total, n);
+            }
+        }
+    }
+
+    namespace detail {
+
+        // Suma de cuadrados de un contenedor de enteros, modulo 2^128
+        template <typename C>
+        constexpr square_sum_t sum_of_squares(C&& contenedor) {
+            using T = std::ranges::range_value_t<C>;
+            if constexpr (std::ranges::contiguous_range<C> && std::ranges::sized_range<C>) {
+                if (!std::is_constant_evaluated()) {
+                    return sum_squares_kernel<T>(std::ranges::data(contenedor), std::ranges::size(contenedor));
+                }
+            }
+            square_sum_t resultado = 0;
+            for (const auto& valor : contenedor) {
+                resultado += square_of(valor);
+            }
+            return resultado;
+        }
+    } // namespace detail
+
+    // Algoritmo variance (varianza)
+    // Reutiliza mean y utiliza concept Iterable, Addable y Divisible
+
+    // Version de dos pasadas: primero la media y despues la suma de cuadrados de las diferencias.
+    // Es la que se usa por defecto para enteros y tipos de usuario.
+    // Los enteros no pasan por la media truncada: la varianza sale exacta de la suma y la suma de cuadrados
+    // en 128 bits (ver detail::integer_variance), truncada y en el tipo de acumulacion
+    template <Iterable C>
+    requires Addable<std::ranges::range_value_t<C>> && detail::Averageable<std::ranges::range_value_t<C>>
+          && std::ranges::forward_range<C>
+    constexpr auto variance(C&& contenedor, two_pass_t) {
+        CORE_NUMERIC_INSTRUMENT_SCOPE(variance, contenedor);
+        using T = std::ranges::range_value_t<C>;
+        std::size_t n = detail::count_of(contenedor);
+
+        if constexpr (std::is_integral_v<T>) {
+            return detail::integer_variance<T>(n, sum(contenedor), detail::sum_of_squares(contenedor));
+        } else {
+            auto promedio = mean(contenedor);
+            if (n == 0) return T{};
+
+            if constexpr (detail::SimdRange<C> && std::floating_point<T>) {
+                // float/double contiguos: kernel SIMD (con FMA si hay AVX2) para la suma de cuadrados
+                if (!std::is_constant_evaluated()) {
+                    return detail::sum_sq_dev_kernel<T>(std::ranges::data(contenedor), n, promedio) / n;
+                }
+            }
+
+            // Multiplicacion directa en vez de std::pow: funciona con cualquier tipo que defina *
+            // (flotantes, Vector3D), es mas barata y se puede evaluar en compilacion
+            T acumulador{};
+            for (const auto& valor : contenedor) {
+                auto diff = valor - promedio; 
+                acumulador = acumulador + (diff * diff);
+            }
+            return acumulador / n;
+        }
+    }
+
+    namespace detail {
+
+        // Estado de Welford/Chan de todo el contenedor.
+        // En float/double contiguos se procesa por bloques del tamaño de L1 con los kernels SIMD
+        // y los bloques se combinan con la formula de Chan. En otros contenedores se usa Welford elemento a elemento
+        template <typename C>
+        constexpr auto moments_of(C&& contenedor) {
+            using T = std::ranges::range_value_t<C>;
+            moments<T> estado;
+
+            if constexpr (SimdRange<C>) {
+                if (!std::is_constant_evaluated()) {
+                    const T* datos = std::ranges::data(contenedor);
+                    const std::size_t n = std::ranges::size(contenedor);
+                    constexpr std::size_t bloque = bloque_l1<T>;
+                    for (std::size_t i = 0; i < n; i += bloque) {
+                        estado.push_block(datos + i, n - i < bloque ? n - i : bloque);
+                    }
+                    return estado;
+                }
+            }
+
+            for (const auto& valor : contenedor) {
+                estado.push(valor);
+            }
+            return estado;
+        }
+    } // namespace detail
+
+    // Version de una pasada (Welford/Chan), numericamente estable.
+    // No aplica a enteros: la actualizacion de la media dividiria en enteros y perderia precision
+    template <Iterable C>
+    requires Addable<std::ranges::range_value_t<C>> && Divisible<std::ranges::range_value_t<C>>
+          && (!std::is_integral_v<std::ranges::range_value_t<C>>)
+    constexpr auto variance(C&& contenedor, one_pass_t) {
+        CORE_NUMERIC_INSTRUMENT_SCOPE(variance, contenedor);
+        using T = std::ranges::range_value_t<C>;
+        auto estado = detail::moments_of(contenedor);
+
+        if (estado.n == 0) return T{};
+        return estado.m2 / estado.n;
+    }
+
+    namespace detail {
+
+        // Varianza de enteros en una pasada: suma, suma de cuadrados y cantidad en el mismo recorrido.
+        // Da el mismo resultado exacto que la version de dos pasadas
+        template <typename C>
+        constexpr auto streaming_integer_variance(C&& contenedor) {
+            using T = std::ranges::range_value_t<C>;
+            accumulation_t<T> suma{};
+            square_sum_t cuadrados = 0;
+            std::size_t n = 0;
+            for (const auto& valor : contenedor) {
+                suma = suma + static_cast<accumulation_t<T>>(valor);
+                cuadrados += square_of(valor);
+                ++n;
+            }
+            return integer_variance<T>(n, suma, cuadrados);
+        }
+    } // namespace detail
+
+    // Por defecto: una pasada para punto flotante, dos pasadas para el resto.
+    // Los rangos de una sola pasada (istream_view, generadores) no se pueden recorrer dos veces:
+    // los enteros llevan suma y suma de cuadrados exactas, los tipos de usuario Welford
+    template <Iterable C>
+    requires Addable<std::ranges::range_value_t<C>> && detail::Averageable<std::ranges::range_value_t<C>>
+    constexpr auto variance(C&& contenedor) {
+        CORE_NUMERIC_INSTRUMENT_SCOPE(variance, contenedor);
+        using T = std::ranges::range_value_t<C>;
+        if constexpr (std::floating_point<T>) {
+            return variance(contenedor, one_pass);
+        } else if constexpr (std::ranges::forward_range<C>) {
+            return variance(contenedor, two_pass);
+        } else if constexpr (std::is_integral_v<T>) {
+            return detail::streaming_integer_variance(contenedor);
+        } else {
+            return variance(contenedor, one_pass);
+        }
+    }
+
+    // Algoritmo max
+    // Busca el maximo elemento
+    // Aqui usamos el concept que creamos "Comparable"
+    template <Iterable C>
+    requires Comparable<std::ranges::range_value_t<C>>
+    constexpr auto max(C&& contenedor) {
+        CORE_NUMERIC_INSTRUMENT_SCOPE(max, contenedor);
+        using T = std::ranges::range_value_t<C>;
+
+        if constexpr (detail::SimdRange<C>) {
+            if (!std::is_constant_evaluated() && !std::ranges::empty(contenedor)) {
+                return detail::max_kernel<T>(std::ranges::data(contenedor), std::ranges::size(contenedor));
+            }
+        }
+
+        // Manejo de contenedor vacio
+        auto it = std::ranges::begin(contenedor);
+        auto fin = std::ranges::end(contenedor);
+        if (it == fin) {
+            return T{};
+        }
+
+        // Itera desde el segundo elemento
+        T maximo = *it;
+        ++it;
+
+        for (; it != fin; ++it) {
+            if (*it > maximo) {
+                maximo = *it;
+            }
+        }
+        return maximo;
+    }
+
+    // Algoritmo min
+    // Busca el minimo elemento con la misma semantica que max (solo necesita el operador >)
+    template <Iterable C>
+    requires Comparable<std::ranges::range_value_t<C>>
+    constexpr auto min(C&& contenedor) {
+        CORE_NUMERIC_INSTRUMENT_SCOPE(min, contenedor);
+        using T = std::ranges::range_value_t<C>;
+
+        if constexpr (detail::SimdRange<C>) {
+            if (!std::is_constant_evaluated() && !std::ranges::empty(contenedor)) {
+                return detail::min_kernel<T>(std::ranges::data(contenedor), std::ranges::size(contenedor));
+            }
+        }
+
+        auto it = std::ranges::begin(contenedor);
+        auto fin = std::ranges::end(contenedor);
+        if (it == fin) {
+            return T{};
+        }
+
+        T minimo = *it;
+        ++it;
+
+        for (; it != fin; ++it) {
+            if (minimo > *it) {
+                minimo = *it;
+            }
+        }
+        return minimo;
+    }
+
+    namespace detail {
+
+        // Minimo y/o maximo con su posicion en un solo recorrido. Los contenedores contiguos de tipos
+        // nativos usan los kernels SIMD; el resto (incluidos los tipos de usuario) un bucle con operator>.
+        // Empates: la primera aparicion. NaN: igual que max, solo se propaga si esta en la primera posicion
+        template <bool Min, bool Max, typename C>
+        constexpr minmax_result<std::ranges::range_value_t<C>> extremes_of(C&& contenedor) {
+            using T = std::ranges::range_value_t<C>;
+            minmax_result<T> resultado;
+
+            if constexpr (SimdRange<C>) {
+                if (!std::is_constant_evaluated() && !std::ranges::empty(contenedor)) {
+                    return extremes_kernel<Min, Max, T>(std::ranges::data(contenedor), std::ranges::size(contenedor));
+                }
+            }
+
+            auto it = std::ranges::begin(contenedor);
+            auto fin = std::ranges::end(contenedor);
+            if (it == fin) {
+                return resultado;
+            }
+
+            T primero = *it;
+            resultado.min = {primero, 0};
+            resultado.max = {primero, 0};
+            ++it;
+            for (std::size_t i = 1; it != fin; ++it, ++i) {
+                if constexpr (Max) {
+                    if (*it > resultado.max.value) resultado.max = {*it, i};
+                }
+                if constexpr (Min) {
+                    if (resultado.min.value > *it) resultado.min = {*it, i};
+                }
+            }
+            return resultado;
+        }
+    } // namespace detail
+
+    // argmax / argmin: el extremo y su posicion en una pasada, sin un std::find posterior.
+    // Con el contenedor vacio devuelven {T{}, 0}
+    template <Iterable C>
+    requires Comparable<std::ranges::range_value_t<C>>
+    constexpr indexed_value<std::ranges::range_value_t<C>> argmax(C&& contenedor) {
+        CORE_NUMERIC_INSTRUMENT_SCOPE(argmax, contenedor);
+        return detail::extremes_of<false, true>(contenedor).max;
+    }
+
+    template <Iterable C>
+    requires Comparable<std::ranges::range_value_t<C>>
+    constexpr indexed_value<std::ranges::range_value_t<C>> argmin(C&& contenedor) {
+        CORE_NUMERIC_INSTRUMENT_SCOPE(argmin, contenedor);
+        return detail::extremes_of<true, false>(contenedor).min;
+    }
+
+    // minmax: minimo y maximo con sus posiciones en la misma pasada
+    template <Iterable C>
+    requires Comparable<std::ranges::range_value_t<C>>
+    constexpr minmax_result<std::ranges::range_value_t<C>> minmax(C&& contenedor) {
+        CORE_NUMERIC_INSTRUMENT_SCOPE(minmax, contenedor);
+        return detail::extremes_of<true, true>(contenedor);
+    }
+
+    // Operacion de reduccion sobre el acumulador A: op(A, A) tiene que poder guardarse en A
+    template <typename Op, typename A>
+    concept ReductionOp = std::invocable<Op&, A, A> && std::convertible_to<std::invoke_result_t<Op&, A, A>, A>;
+
+    namespace detail {
+
+        // Bucle de transform_reduce en orden, un elemento a la vez
+        template <typename C, typename A, typename Op, typename Func>
+        constexpr A transform_reduce_loop(C&& contenedor, A resultado, Op& op, Func& funcion) {
+            for (auto&& valor : contenedor) {
+                resultado = static_cast<A>(op(std::move(resultado), static_cast<A>(funcion(valor))));
+            }
+            return resultado;
+        }
+
+        // Casos con kernel: rango contiguo de un tipo nativo, acumulador nativo y operacion reordenable
+        template <typename C, typename A, typename Op>
+        concept FoldableRange = ArithmeticRange<C> && std::is_arithmetic_v<A> && is_reassociable_v<Op>;
+    } // namespace detail
+
+    // Algoritmo transform_reduce generalizado: reduce op(inicial, funcion(valor)...) acumulando en el tipo
+    // de inicial, que puede ser mas ancho que el de los elementos (int8 a int32, float a double).
+    // Si op es conocida como reordenable (is_reassociable) y el rango es contiguo de un tipo nativo, la
+    // funcion y la operacion se inlinean en el kernel del ISA activo; si no, se aplica en orden
+    template <Iterable C, typename A, typename Op, typename Func>
+    requires ReductionOp<Op, A> && std::invocable<Func&, std::ranges::range_reference_t<C>>
+    constexpr A transform_reduce(C&& contenedor, A inicial, Op op, Func funcion) {
+        CORE_NUMERIC_INSTRUMENT_SCOPE(transform_reduce, contenedor);
+        if constexpr (detail::FoldableRange<C, A, Op>) {
+            if (!std::is_constant_evaluated()) {
+                return detail::transform_fold_kernel(std::ranges::data(contenedor), std::ranges::size(contenedor),
+                                                     inicial, op, funcion);
+            }
+        }
+        return detail::transform_reduce_loop(contenedor, std::move(inicial), op, funcion);
+    }
+
+    namespace detail {
+
+        // Elementos que se recorren a la par en dos rangos con tamaño: los del mas corto
+        template <typename C1, typename C2>
+        constexpr std::size_t paired_count(C1&& primero, C2&& segundo) {
+            auto n1 = static_cast<std::size_t>(std::ranges::size(primero));
+            auto n2 = static_cast<std::size_t>(std::ranges::size(segundo));
+            return n1 < n2 ? n1 : n2;
+        }
+
+        // Bucle de transform_reduce de dos entradas en orden. Se detiene al acabar el rango mas corto
+        template <typename C1, typename C2, typename A, typename Op, typename Func>
+        constexpr A transform_reduce_loop(C1&& primero, C2&& segundo, A resultado, Op& op, Func& funcion) {
+            auto it1 = std::ranges::begin(primero);
+            auto fin1 = std::ranges::end(primero);
+            auto it2 = std::ranges::begin(segundo);
+            auto fin2 = std::ranges::end(segundo);
+            for (; it1 != fin1 && it2 != fin2; ++it1, ++it2) {
+                resultado = static_cast<A>(op(std::move(resultado), static_cast<A>(funcion(*it1, *it2))));
+            }
+            return resultado;
+        }
+    } // namespace detail
+
+    // transform_reduce de dos entradas: reduce op(inicial, funcion(a[i], b[i])...) sin armar un vector de pares.
+    // Recorre los dos rangos a la par y para en el mas corto. Con dos rangos contiguos de tipos nativos y una
+    // operacion reordenable usa el kernel del ISA activo, igual que la version de una entrada
+    template <Iterable C1, Iterable C2, typename A, typename Op, typename Func>
+    requires ReductionOp<Op, A>
+          && std::invocable<Func&, std::ranges::range_reference_t<C1>, std::ranges::range_reference_t<C2>>
+    constexpr A transform_reduce(C1&& primero, C2&& segundo, A inicial, Op op, Func funcion) {
+        CORE_NUMERIC_INSTRUMENT_SCOPE(transform_reduce, primero);
+        if constexpr (detail::FoldableRange<C1, A, Op> && detail::ArithmeticRange<C2>) {
+            if (!std::is_constant_evaluated()) {
+                const std::size_t n = detail::paired_count(primero, segundo);
+                return detail::transform_fold_kernel(std::ranges::data(primero), std::ranges::data(segundo), n,
+                                                     inicial, op, funcion);
+            }
+        }
+        return detail::transform_reduce_loop(primero, segundo, std::move(inicial), op, funcion);
+    }
+
+    // dot: suma de a[i] * b[i] acumulando en accumulation_t, asi los enteros no desbordan.
+    // Los flotantes contiguos usan un kernel con FMA y varios acumuladores; el resto (enteros, Vector3D, ...)
+    // pasa por transform_reduce con los operadores * y + del tipo. Para en el rango mas corto
+    template <Iterable C1, Iterable C2>
+    requires std::same_as<std::ranges::range_value_t<C1>, std::ranges::range_value_t<C2>>
+          && Multipliable<std::ranges::range_value_t<C1>>
+          && Addable<accumulation_t<std::ranges::range_value_t<C1>>>
+    constexpr auto dot(C1&& primero, C2&& segundo) {
+        CORE_NUMERIC_INSTRUMENT_SCOPE(dot, primero);
+        using T = std::ranges::range_value_t<C1>;
+        using A = accumulation_t<T>;
+
+        if constexpr (detail::SimdRange<C1> && detail::SimdRange<C2> && std::floating_point<T>) {
+            if (!std::is_constant_evaluated()) {
+                const std::size_t n = detail::paired_count(primero, segundo);
+                return detail::dot_kernel(std::ranges::data(primero), std::ranges::data(segundo), n);
+            }
+        }
+        return core_numeric::transform_reduce(primero, segundo, A{}, std::plus<A>{}, [](const T& x, const T& y) {
+            if constexpr (std::same_as<A, T>) {
+                return x * y;
+            } else {
+                return static_cast<A>(x) * static_cast<A>(y);
+            }
+        });
+    }
+
+    // Algoritmo transform_reduce
+    // Recibe una función para transformar cada elemento antes de sumar.
+    // Lo utilizaremos en el test.cpp para sumar cuadrados.
+    // Es la version generalizada con inicial T{} y std::plus, acumulando en el tipo de los elementos
+    template <Iterable C, typename Func>
+    requires Addable<std::ranges::range_value_t<C>>
+    constexpr auto transform_reduce(C&& contenedor, Func funcion) {
+        CORE_NUMERIC_INSTRUMENT_SCOPE(transform_reduce, contenedor);
+        using T = std::ranges::range_value_t<C>;
+        return core_numeric::transform_reduce(contenedor, T{}, std::plus<T>{}, funcion);
+    }
+
+
+    // EJECUCION PARALELA:
+
+    // Politicas de ejecucion, con los mismos nombres que std::execution.
+    // threads = 0 usa todos los hilos de hardware
+    namespace execution {
+
+        // Un solo hilo: equivale a llamar al algoritmo sin politica
+        struct sequenced_policy {};
+
+        // Varios hilos. La funcion de transform_reduce se llama en orden dentro de cada trozo
+        struct parallel_policy {
+            unsigned threads = 0;
+            constexpr parallel_policy with_threads(unsigned n) const { return parallel_policy{n}; }
+        };
+
+        // Varios hilos y ademas la funcion de transform_reduce puede intercalarse en carriles SIMD
+        struct parallel_unsequenced_policy {
+            unsigned threads = 0;
+            constexpr parallel_unsequenced_policy with_threads(unsigned n) const { return parallel_unsequenced_policy{n}; }
+        };
+
+        inline constexpr sequenced_policy seq{};
+        inline constexpr parallel_policy par{};
+        inline constexpr parallel_unsequenced_policy par_unseq{};
+
+        template <typename P>
+        inline constexpr bool is_execution_policy_v = false;
+        template <>
+        inline constexpr bool is_execution_policy_v<sequenced_policy> = true;
+        template <>
+        inline constexpr bool is_execution_policy_v<parallel_policy> = true;
+        template <>
+        inline constexpr bool is_execution_policy_v<parallel_unsequenced_policy> = true;
+    } // namespace execution
+
+    template <typename P>
+    concept ExecutionPolicy = execution::is_execution_policy_v<std::remove_cvref_t<P>>;
+
+    namespace detail {
+
+        // Solo se reparten rangos con acceso aleatorio y tamaño conocido que se puedan recorrer como const:
+        // los hilos llaman a begin() a la vez, y las vistas que guardan su begin() en cache
+        // (filter, drop_while, ...) solo lo permiten sin const, asi que esas se reducen en secuencia
+        template <typename C>
+        concept Splittable = std::ranges::random_access_range<const std::remove_reference_t<C>>
+                          && std::ranges::sized_range<const std::remove_reference_t<C>>;
+
+        // Por debajo de este numero de elementos por hilo no compensa repartir: con el pool persistente
+        // el fork-join cuesta unos microsegundos, lo que tarda un hilo en sumar unos 16k doubles en L2
+        inline constexpr std::size_t grano_paralelo = std::size_t{1} << 14;
+
+        // Trozo [desde, hasta) de un rango, como subrange: es contiguo si el rango lo es,
+        // asi cada hilo sigue usando los kernels SIMD
+        template <typename C>
+        auto make_slice(const C& contenedor, std::size_t desde, std::size_t hasta) {
+            auto inicio = std::ranges::begin(contenedor);
+            return std::ranges::subrange(inicio + desde, inicio + hasta);
+        }
+
+        // Tope de trozos por llamada: el pool lleva el indice de trozo en 16 bits
+        inline constexpr unsigned max_trozos = 0xFFFF;
+
+        // Numero de hilos (trozos) para n elementos
+        template <typename P>
+        unsigned thread_count(const P& politica, std::size_t n) {
+            unsigned hilos = politica.threads;
+            if (hilos == 0) hilos = std::thread::hardware_concurrency();
+            if (hilos == 0) hilos = 1;
+            if (hilos > max_trozos) hilos = max_trozos;
+            std::size_t por_grano = (n + grano_paralelo - 1) / grano_paralelo;
+            if (por_grano < hilos) hilos = static_cast<unsigned>(por_grano > 0 ? por_grano : 1);
+            return hilos;
+        }
+
+        // Granulo de reparto de un rango: los limites de los trozos caen en multiplos de el.
+        // Por defecto 1; un rango puede pedir otro con un miembro chunk_granule() (mapped_column
+        // lo usa para que cada hilo lea paginas enteras y distintas)
+        template <typename C>
+        std::size_t chunk_granule(const C& contenedor) {
+            if constexpr (requires { { contenedor.chunk_granule() } -> std::convertible_to<std::size_t>; }) {
+                std::size_t granulo = contenedor.chunk_granule();
+                return granulo > 0 ? granulo : 1;
+            } else {
+                return 1;
+            }
+        }
+
+        // Espera activa corta: avisa a la CPU de que es un bucle de espera (libera recursos para el otro
+        // hilo del nucleo y no castiga la salida del bucle con una mala prediccion de memoria)
+        inline void pausa() {
+#if CORE_NUMERIC_X86
+            _mm_pause();
+#else
+            std::this_thread::yield();
+#endif
+        }
+
+        // Pool fork-join persistente de las politicas paralelas. Crear hilos en cada llamada cuesta decenas
+        // de microsegundos, mas que toda una reduccion de 100k doubles. Los trabajadores del pool se crean
+        // una vez (uno menos que los nucleos, que el que llama tambien trabaja), cada uno fijo en un nucleo
+        // en Linux; despues de cada trabajo esperan girando un rato por el siguiente y luego se duermen
+        // con std::atomic::wait.
+        //
+        // Un trabajo son 'tareas' indices que se reparten sobre la marcha: el que llama y los trabajadores
+        // toman el siguiente libre hasta agotarlos, asi puede haber mas tareas que hilos. La palabra
+        // 'estado' junta la generacion del trabajo (32 bits), el siguiente indice y el total (16 bits cada
+        // uno): un trabajador que despierta tarde no puede tomar un indice de un trabajo que ya termino,
+        // porque la generacion ya no coincide
+        class fork_join_pool {
+        public:
+            static constexpr unsigned max_tareas = max_trozos;
+
+            static fork_join_pool& instance() {
+                static fork_join_pool pool;
+                return pool;
+            }
+
+            unsigned workers() const { return static_cast<unsigned>(hilos_.size()); }
+
+            // Ejecuta tarea(k) para k en [0, tareas) y vuelve cuando terminaron todas.
+            // Devuelve false sin ejecutar nada si el pool ya esta ocupado (otro hilo lo usa, o una tarea
+            // llama a su vez a un algoritmo paralelo): en ese caso el que llama reparte con hilos propios.
+            // Ocupado es una bandera atomica y no un mutex: en la llamada anidada el hilo que pregunta puede
+            // ser el mismo que tiene el pool, y try_lock sobre un mutex propio es comportamiento indefinido.
+            // tarea no debe lanzar excepciones (run_chunks las captura antes); tareas <= max_tareas
+            template <typename Tarea>
+            bool run(unsigned tareas, Tarea& tarea) {
+                if (tareas == 0) return true;
+                if (ocupado_.exchange(true, std::memory_order_acquire)) return false;
+
+                funcion_ = &invocar<Tarea>;
+                contexto_ = &tarea;
+                pendientes_.store(tareas, std::memory_order_relaxed);
+                generacion_ = (generacion_ + 1) & 0xFFFFFFFFu;
+                const std::uint64_t nuevo = (generacion_ << 32) | tareas;
+                estado_.store(nuevo, std::memory_order_seq_cst);
+                if (dormidos_.load(std::memory_order_seq_cst) > 0) {
+                    estado_.notify_all();
+                }
+
+                participar(nuevo);
+                for (unsigned giro = 0; pendientes_.load(std::memory_order_acquire) != 0; ++giro) {
+                    if (giro < giros_espera) {
+                        pausa();
+                    } else {
+                        std::this_thread::yield();
+                    }
+                }
+                ocupado_.store(false, std::memory_order_release);
+                return true;
+            }
+
+            ~fork_join_pool() {
+                parar_.store(true, std::memory_order_seq_cst);
+                while (ocupado_.exchange(true, std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                }
+                generacion_ = (generacion_ + 1) & 0xFFFFFFFFu;
+                estado_.store(generacion_ << 32, std::memory_order_seq_cst);
+                estado_.notify_all();
+                for (auto& hilo : hilos_) {
+                    hilo.join();
+                }
+            }
+
+            fork_join_pool(const fork_join_pool&) = delete;
+            fork_join_pool& operator=(const fork_join_pool&) = delete;
+
+        private:
+            // Vueltas de espera activa antes de dormir: del orden de decenas de microsegundos,
+            // suficiente para encadenar llamadas seguidas sin pasar por el kernel
+            static constexpr unsigned giros_espera = 1u << 12;
+
+            template <typename Tarea>
+            static void invocar(void* contexto, unsigned k) {
+                (*static_cast<Tarea*>(contexto))(k);
+            }
+
+            fork_join_pool() {
+                std::vector<int> nucleos = nucleos_permitidos();
+                unsigned total = std::thread::hardware_concurrency();
+                if (!nucleos.empty()) total = static_cast<unsigned>(nucleos.size());
+                if (total <= 1) return;
+                // Solo se fija la afinidad si hay un nucleo para cada trabajador ademas del primero
+                const bool fijar = nucleos.size() >= total;
+                hilos_.reserve(total - 1);
+                for (unsigned w = 0; w + 1 < total; ++w) {
+                    int nucleo = fijar ? nucleos[w + 1] : -1;
+                    hilos_.emplace_back([this, nucleo] { trabajar(nucleo); });
+                }
+            }
+
+            // Nucleos en la mascara de afinidad del proceso (respeta taskset y cgroups), vacio si no se sabe
+            static std::vector<int> nucleos_permitidos() {
+                std::vector<int> nucleos;
+#if CORE_NUMERIC_AFFINITY
+                cpu_set_t mascara;
+                CPU_ZERO(&mascara);
+                if (::sched_getaffinity(0, sizeof(mascara), &mascara) == 0) {
+                    for (int c = 0; c < CPU_SETSIZE; ++c) {
+                        if (CPU_ISSET(c, &mascara)) nucleos.push_back(c);
+                    }
+                }
+#endif
+                return nucleos;
+            }
+
+            void trabajar(int nucleo) {
+#if CORE_NUMERIC_AFFINITY
+                if (nucleo >= 0) {
+                    cpu_set_t mascara;
+                    CPU_ZERO(&mascara);
+                    CPU_SET(nucleo, &mascara);
+                    ::pthread_setaffinity_np(::pthread_self(), sizeof(mascara), &mascara);
+                }
+#else
+                (void)nucleo;
+#endif
+                std::uint64_t visto = estado_.load(std::memory_order_acquire) >> 32;
+                while (true) {
+                    std::uint64_t actual = esperar(visto);
+                    if (parar_.load(std::memory_order_acquire)) return;
+                    visto = actual >> 32;
+                    participar(actual);
+                }
+            }
+
+            // Espera a una generacion distinta de 'visto': primero girando y despues dormido
+            std::uint64_t esperar(std::uint64_t visto) {
+                for (unsigned giro = 0; giro < giros_espera; ++giro) {
+                    std::uint64_t actual = estado_.load(std::memory_order_acquire);
+                    if ((actual >> 32) != visto) return actual;
+                    pausa();
+                }
+                while (true) {
+                    std::uint64_t actual = estado_.load(std::memory_order_acquire);
+                    if ((actual >> 32) != visto) return actual;
+                    // Se anota como dormido antes de volver a mirar: run() despierta si ve a alguien anotado,
+                    // y si no lo ve es que este hilo va a leer el estado nuevo
+                    dormidos_.fetch_add(1, std::memory_order_seq_cst);
+                    actual = estado_.load(std::memory_order_seq_cst);
+                    if ((actual >> 32) == visto) {
+                        estado_.wait(actual, std::memory_order_acquire);
+                    }
+                    dormidos_.fetch_sub(1, std::memory_order_relaxed);
+                }
+            }
+
+            // Toma indices del trabajo 'publicado' hasta que no queden (o hasta que empiece otro)
+            void participar(std::uint64_t publicado) {
+                const std::uint64_t generacion = publicado >> 32;
+                std::uint64_t actual = estado_.load(std::memory_order_acquire);
+                while (true) {
+                    const unsigned siguiente = static_cast<unsigned>((actual >> 16) & 0xFFFF);
+                    const unsigned tareas = static_cast<unsigned>(actual & 0xFFFF);
+                    if ((actual >> 32) != generacion || siguiente >= tareas) return;
+                    if (!estado_.compare_exchange_weak(actual, actual + (std::uint64_t{1} << 16),
+                                                       std::memory_order_acq_rel, std::memory_order_acquire)) {
+                        continue;
+                    }
+                    // Mientras este indice no termine, run() no vuelve: funcion_ y contexto_ siguen validos
+                    funcion_(contexto_, siguiente);
+                    pendientes_.fetch_sub(1, std::memory_order_acq_rel);
+                    actual = estado_.load(std::memory_order_acquire);
+                }
+            }
+
+            std::vector<std::thread> hilos_;
+            std::atomic<bool> ocupado_{false};                 // Un trabajo a la vez
+            std::uint64_t generacion_ = 0;                     // Solo la toca quien tiene ocupado_
+            void (*funcion_)(void*, unsigned) = nullptr;
+            void* contexto_ = nullptr;
+            alignas(64) std::atomic<std::uint64_t> estado_{0}; // generacion | siguiente | tareas
+            alignas(64) std::atomic<unsigned> pendientes_{0};
+            alignas(64) std::atomic<unsigned> dormidos_{0};
+            std::atomic<bool> parar_{false};
+        };
+
+        // Reparte [0, n) en 'hilos' trozos y ejecuta tarea(trozo, desde, hasta) en paralelo.
+        // Los limites entre trozos son multiplos de 'granulo' y ningun trozo queda vacio
+        // (si hay menos granulos que hilos se usan menos hilos).
+        // Los trozos corren en el pool persistente, donde el hilo que llama tambien toma trozos.
+        // Devuelve los parciales en orden.
+        // Si alguna tarea lanza una excepcion se relanza despues de esperar a todos los hilos
+        template <typename R, typename Tarea>
+        std::vector<R> run_chunks(std::size_t n, unsigned hilos, Tarea tarea, std::size_t granulo = 1) {
+            if (hilos > max_trozos) hilos = max_trozos;
+            const std::size_t granulos = n / granulo;
+            if (granulos < hilos) hilos = static_cast<unsigned>(granulos > 0 ? granulos : 1);
+            auto limite = [&](unsigned k) {
+                return k == hilos ? n : granulos * k / hilos * granulo;
+            };
+            std::vector<R> parciales(hilos);
+            std::vector<std::exception_ptr> errores(hilos);
+            auto ejecutar = [&](unsigned k) {
+                CORE_NUMERIC_INSTRUMENT_WORKER();
+                std::size_t desde = limite(k);
+                std::size_t hasta = limite(k + 1);
+                try {
+                    parciales[k] = tarea(k, desde, hasta);
+                } catch (...) {
+                    errores[k] = std::current_exception();
+                }
+            };
+
+            // Con el pool ocupado (llamadas paralelas desde varios hilos, o anidadas) se crean hilos, no mas
+            // que los de hardware: toman los trozos de un contador, asi los trozos no dependen de los hilos
+            if (!fork_join_pool::instance().run(hilos, ejecutar)) {
+                std::atomic<unsigned> siguiente{0};
+                auto tomar = [&] {
+                    for (unsigned k = siguiente.fetch_add(1); k < hilos; k = siguiente.fetch_add(1)) {
+                        ejecutar(k);
+                    }
+                };
+                unsigned propios = std::thread::hardware_concurrency();
+                if (propios == 0 || propios > hilos) propios = hilos;
+                std::vector<std::thread> trabajadores;
+                trabajadores.reserve(propios - 1);
+                for (unsigned t = 1; t < propios; ++t) {
+                    trabajadores.emplace_back(tomar);
+                }
+                tomar();
+                for (auto& hilo : trabajadores) {
+                    hilo.join();
+                }
+            }
+            for (auto& error : errores) {
+                if (error) std::rethrow_exception(error);
+            }
+            return parciales;
+        }
+
+        // Combina los parciales en arbol (pares vecinos en cada nivel), asi el error
+        // de redondeo crece con log(hilos) y no con el numero de hilos
+        template <typename T, typename Op>
+        T tree_combine(std::vector<T> parciales, Op combinar) {
+            if (parciales.empty()) return T{};
+            std::size_t cantidad = parciales.size();
+            while (cantidad > 1) {
+                std::size_t mitad = (cantidad + 1) / 2;
+                for (std::size_t i = 0; i < cantidad / 2; ++i) {
+                    parciales[i] = combinar(parciales[2 * i], parciales[2 * i + 1]);
+                }
+                if (cantidad % 2 == 1) {
+                    parciales[mitad - 1] = parciales[cantidad - 1];
+                }
+                cantidad = mitad;
+            }
+            return parciales[0];
+        }
+
+        // Parcial de max: un trozo puede quedar vacio si solo tiene NaN
+        template <typename T>
+        struct max_parcial {
+            bool valido = false;
+            T valor{};
+        };
+    } // namespace detail
+
+    // sum con politica de ejecucion: suma por trozos y combinacion en arbol
+    template <ExecutionPolicy P, Iterable C>
+    requires Addable<std::ranges::range_value_t<C>>
+    auto sum(const P& politica, C&& contenedor) {
+        CORE_NUMERIC_INSTRUMENT_SCOPE(sum, contenedor);
+        using A = accumulation_t<std::ranges::range_value_t<C>>;
+        if constexpr (std::same_as<std::remove_cvref_t<P>, execution::sequenced_policy> || !detail::Splittable<C>) {
+            return sum(contenedor);
+        } else {
+            const std::size_t n = std::ranges::size(contenedor);
+            unsigned hilos = detail::thread_count(politica, n);
+            if (hilos <= 1) return sum(contenedor);
+
+            auto parciales = detail::run_chunks<A>(n, hilos, [&](unsigned, std::size_t desde, std::size_t hasta) {
+                return sum(detail::make_slice(contenedor, desde, hasta));
+            }, detail::chunk_granule(contenedor));
+            return detail::tree_combine(std::move(parciales), [](const A& a, const A& b) { return a + b; });
+        }
+    }
+
+    // sum con politica de ejecucion y modo de suma: cada hilo suma su trozo con el modo pedido.
+    // Con kbn los parciales tambien se combinan con compensacion, con los demas en arbol
+    template <ExecutionPolicy P, Iterable C, SummationPolicy S>
+    requires Addable<std::ranges::range_value_t<C>> && requires (C& c, S modo) { sum(c, modo); }
+    auto sum(const P& politica, C&& contenedor, S modo) {
+        CORE_NUMERIC_INSTRUMENT_SCOPE(sum, contenedor);
+        using T = decltype(sum(contenedor, modo));
+        if constexpr (std::same_as<std::remove_cvref_t<P>, execution::sequenced_policy> || !detail::Splittable<C>) {
+            return sum(contenedor, modo);
+        } else {
+            const std::size_t n = std::ranges::size(contenedor);
+            unsigned hilos = detail::thread_count(politica, n);
+            if (hilos <= 1) return sum(contenedor, modo);
+
+            auto parciales = detail::run_chunks<T>(n, hilos, [&](unsigned, std::size_t desde, std::size_t hasta) {
+                return sum(detail::make_slice(contenedor, desde, hasta), modo);
+            }, detail::chunk_granule(contenedor));
+            if constexpr (std::same_as<S, kbn_t> && std::floating_point<T>) {
+                std::size_t cantidad = 0;
+                return detail::neumaier_sum(parciales, cantidad);
+            } else {
+                return detail::tree_combine(std::move(parciales), [](const T& a, const T& b) { return a + b; });
+            }
+        }
+    }
+
+    // mean con politica de ejecucion: reutiliza sum en paralelo
+    template <ExecutionPolicy P, Iterable C>
+    requires detail::Averageable<std::ranges::range_value_t<C>> && Addable<std::ranges::range_value_t<C>>
+    auto mean(const P& politica, C&& contenedor) {
+        CORE_NUMERIC_INSTRUMENT_SCOPE(mean, contenedor);
+        if constexpr (!std::ranges::sized_range<C>) {
+            return mean(contenedor);
+        } else {
+            auto suma_total = sum(politica, contenedor);
+            return detail::mean_of_sum<std::ranges::range_value_t<C>>(suma_total, std::ranges::size(contenedor));
+        }
+    }
+
+    // variance con politica de ejecucion.
+    // Punto flotante: cada hilo calcula su estado de Welford/Chan y los estados se combinan con Chan.
+    // Enteros: cada hilo calcula su suma y su suma de cuadrados, que se suman de forma exacta.
+    // Resto: dos pasadas, media en paralelo y despues suma de cuadrados por trozos
+    template <ExecutionPolicy P, Iterable C>
+    requires Addable<std::ranges::range_value_t<C>> && detail::Averageable<std::ranges::range_value_t<C>>
+    auto variance(const P& politica, C&& contenedor) {
+        CORE_NUMERIC_INSTRUMENT_SCOPE(variance, contenedor);
+        using T = std::ranges::range_value_t<C>;
+        if constexpr (std::same_as<std::remove_cvref_t<P>, execution::sequenced_policy> || !detail::Splittable<C>) {
+            return variance(contenedor);
+        } else {
+            const std::size_t n = std::ranges::size(contenedor);
+            unsigned hilos = detail::thread_count(politica, n);
+            if (hilos <= 1) return variance(contenedor);
+
+            if constexpr (std::floating_point<T>) {
+                auto parciales = detail::run_chunks<detail::moments<T>>(n, hilos, [&](unsigned, std::size_t desde, std::size_t hasta) {
+                    return detail::moments_of(detail::make_slice(contenedor, desde, hasta));
+                }, detail::chunk_granule(contenedor));
+                auto estado = detail::tree_combine(std::move(parciales), [](detail::moments<T> a, const detail::moments<T>& b) {
+                    a.merge(b);
+                    return a;
+                });
+                return estado.m2 / estado.n;
+            } else if constexpr (std::is_integral_v<T>) {
+                struct parcial {
+                    accumulation_t<T> suma{};
+                    detail::square_sum_t cuadrados = 0;
+                };
+                auto parciales = detail::run_chunks<parcial>(n, hilos, [&](unsigned, std::size_t desde, std::size_t hasta) {
+                    auto trozo = detail::make_slice(contenedor, desde, hasta);
+                    return parcial{sum(trozo), detail::sum_of_squares(trozo)};
+                }, detail::chunk_granule(contenedor));
+                auto total = detail::tree_combine(std::move(parciales), [](const parcial& a, const parcial& b) {
+                    return parcial{a.suma + b.suma, a.cuadrados + b.cuadrados};
+                });
+                return detail::integer_variance<T>(n, total.suma, total.cuadrados);
+            } else {
+                auto promedio = mean(politica, contenedor);
+                auto parciales = detail::run_chunks<T>(n, hilos, [&](unsigned, std::size_t desde, std::size_t hasta) {
+                    T acumulador{};
+                    for (const auto& valor : detail::make_slice(contenedor, desde, hasta)) {
+                        auto diff = valor - promedio;
+                        acumulador = acumulador + (diff * diff);
+                    }
+                    return acumulador;
+                }, detail::chunk_granule(contenedor));
+                return detail::tree_combine(std::move(parciales), [](const T& a, const T& b) { return a + b; }) / n;
+            }
+        }
+    }
+
+    // max con politica de ejecucion. Mantiene la semantica de la version secuencial:
+    // solo un NaN en la primera posicion del contenedor se propaga, por eso los trozos
+    // que no son el primero saltan los NaN iniciales antes de buscar su maximo
+    template <ExecutionPolicy P, Iterable C>
+    requires Comparable<std::ranges::range_value_t<C>>
+    auto max(const P& politica, C&& contenedor) {
+        CORE_NUMERIC_INSTRUMENT_SCOPE(max, contenedor);
+        using T = std::ranges::range_value_t<C>;
+        if constexpr (std::same_as<std::remove_cvref_t<P>, execution::sequenced_policy> || !detail::Splittable<C>) {
+            return max(contenedor);
+        } else {
+            const std::size_t n = std::ranges::size(contenedor);
+            unsigned hilos = detail::thread_count(politica, n);
+            if (hilos <= 1) return max(contenedor);
+
+            auto parciales = detail::run_chunks<detail::max_parcial<T>>(n, hilos, [&](unsigned k, std::size_t desde, std::size_t hasta) {
+                if constexpr (std::floating_point<T>) {
+                    auto it = std::ranges::begin(contenedor);
+                    while (k > 0 && desde < hasta && it[desde] != it[desde]) ++desde;
+                }
+                if (desde == hasta) return detail::max_parcial<T>{};
+                return detail::max_parcial<T>{true, max(detail::make_slice(contenedor, desde, hasta))};
+            }, detail::chunk_granule(contenedor));
+
+            T maximo = parciales[0].valor;
+            for (std::size_t k = 1; k < parciales.size(); ++k) {
+                if (parciales[k].valido && parciales[k].valor > maximo) {
+                    maximo = parciales[k].valor;
+                }
+            }
+            return maximo;
+        }
+    }
+
+    // transform_reduce generalizado con politica de ejecucion: cada trozo se reduce por separado y se combina
+    // en arbol, asi que op tiene que ser asociativa. Cada trozo empieza con su primer elemento transformado
+    // (no hace falta el neutro de op) y el inicial se combina una sola vez al final. Con maximum/minimum
+    // la semilla salta los NaN del principio del trozo, que en el bucle en orden se habrian ignorado.
+    // Con par la funcion se aplica en orden dentro de cada trozo, con par_unseq se usan los kernels por carriles
+    template <ExecutionPolicy P, Iterable C, typename A, typename Op, typename Func>
+    requires ReductionOp<Op, A> && std::invocable<Func&, std::ranges::range_reference_t<C>>
+    A transform_reduce(const P& politica, C&& contenedor, A inicial, Op op, Func funcion) {
+        CORE_NUMERIC_INSTRUMENT_SCOPE(transform_reduce, contenedor);
+        using Politica = std::remove_cvref_t<P>;
+        if constexpr (std::same_as<Politica, execution::sequenced_policy> || !detail::Splittable<C>) {
+            return core_numeric::transform_reduce(contenedor, std::move(inicial), op, funcion);
+        } else {
+            const std::size_t n = std::ranges::size(contenedor);
+            unsigned hilos = detail::thread_count(politica, n);
+            if (hilos <= 1) return core_numeric::transform_reduce(contenedor, std::move(inicial), op, funcion);
+
+            auto parciales = detail::run_chunks<A>(n, hilos, [&](unsigned, std::size_t desde, std::size_t hasta) {
+                Func copia = funcion;
+                Op op_trozo = op;
+                auto inicio = std::ranges::begin(contenedor);
+                std::size_t i = desde;
+                A primero = static_cast<A>(copia(*(inicio + i)));
+                while (detail::empty_seed<Op>(primero) && ++i < hasta) {
+                    primero = static_cast<A>(copia(*(inicio + i)));
+                }
+                auto resto = detail::make_slice(contenedor, i < hasta ? i + 1 : hasta, hasta);
+                if constexpr (std::same_as<Politica, execution::parallel_unsequenced_policy>) {
+                    return core_numeric::transform_reduce(resto, std::move(primero), op_trozo, copia);
+                } else {
+                    return detail::transform_reduce_loop(resto, std::move(primero), op_trozo, copia);
+                }
+            }, detail::chunk_granule(contenedor));
+            A total = detail::tree_combine(std::move(parciales), [&](const A& a, const A& b) {
+                return detail::fold_step(op, a, b);
+            });
+            return static_cast<A>(op(std::move(inicial), std::move(total)));
+        }
+    }
+
+    // transform_reduce de dos entradas con politica: los dos rangos se parten en los mismos trozos
+    template <ExecutionPolicy P, Iterable C1, Iterable C2, typename A, typename Op, typename Func>
+    requires ReductionOp<Op, A>
+          && std::invocable<Func&, std::ranges::range_reference_t<C1>, std::ranges::range_reference_t<C2>>
+    A transform_reduce(const P& politica, C1&& primero, C2&& segundo, A inicial, Op op, Func funcion) {
+        CORE_NUMERIC_INSTRUMENT_SCOPE(transform_reduce, primero);
+        using Politica = std::remove_cvref_t<P>;
+        if constexpr (std::same_as<Politica, execution::sequenced_policy>
+                      || !detail::Splittable<C1> || !detail::Splittable<C2>) {
+            return core_numeric::transform_reduce(primero, segundo, std::move(inicial), op, funcion);
+        } else {
+            const std::size_t n = detail::paired_count(primero, segundo);
+            unsigned hilos = detail::thread_count(politica, n);
+            if (hilos <= 1) return core_numeric::transform_reduce(primero, segundo, std::move(inicial), op, funcion);
+
+            auto parciales = detail::run_chunks<A>(n, hilos, [&](unsigned, std::size_t desde, std::size_t hasta) {
+                Func copia = funcion;
+                Op op_trozo = op;
+                auto inicio1 = std::ranges::begin(primero);
+                auto inicio2 = std::ranges::begin(segundo);
+                std::size_t i = desde;
+                A inicio = static_cast<A>(copia(*(inicio1 + i), *(inicio2 + i)));
+                while (detail::empty_seed<Op>(inicio) && ++i < hasta) {
+                    inicio = static_cast<A>(copia(*(inicio1 + i), *(inicio2 + i)));
+                }
+                const std::size_t desde_resto = i < hasta ? i + 1 : hasta;
+                auto resto1 = detail::make_slice(primero, desde_resto, hasta);
+                auto resto2 = detail::make_slice(segundo, desde_resto, hasta);
+                if constexpr (std::same_as<Politica, execution::parallel_unsequenced_policy>) {
+                    return core_numeric::transform_reduce(resto1, resto2, std::move(inicio), op_trozo, copia);
+                } else {
+                    return detail::transform_reduce_loop(resto1, resto2, std::move(inicio), op_trozo, copia);
+                }
+            }, detail::chunk_granule(primero));
+            A total = detail::tree_combine(std::move(parciales), [&](const A& a, const A& b) {
+                return detail::fold_step(op, a, b);
+            });
+            return static_cast<A>(op(std::move(inicial), std::move(total)));
+        }
+    }
+
+    // dot con politica: cada trozo usa el kernel de dot y los parciales se suman en arbol
+    template <ExecutionPolicy P, Iterable C1, Iterable C2>
+    requires std::same_as<std::ranges::range_value_t<C1>, std::ranges::range_value_t<C2>>
+          && Multipliable<std::ranges::range_value_t<C1>>
+          && Addable<accumulation_t<std::ranges::range_value_t<C1>>>
+    auto dot(const P& politica, C1&& primero, C2&& segundo) {
+        CORE_NUMERIC_INSTRUMENT_SCOPE(dot, primero);
+        using A = accumulation_t<std::ranges::range_value_t<C1>>;
+        using Politica = std::remove_cvref_t<P>;
+        if constexpr (std::same_as<Politica, execution::sequenced_policy>
+                      || !detail::Splittable<C1> || !detail::Splittable<C2>) {
+            return dot(primero, segundo);
+        } else {
+            const std::size_t n = detail::paired_count(primero, segundo);
+            unsigned hilos = detail::thread_count(politica, n);
+            if (hilos <= 1) return dot(primero, segundo);
+
+            auto parciales = detail::run_chunks<A>(n, hilos, [&](unsigned, std::size_t desde, std::size_t hasta) {
+                return static_cast<A>(dot(detail::make_slice(primero, desde, hasta), detail::make_slice(segundo, desde, hasta)));
+            }, detail::chunk_granule(primero));
+            return detail::tree_combine(std::move(parciales), [](const A& a, const A& b) { return a + b; });
+        }
+    }
+
+    // transform_reduce con politica de ejecucion: suma de funcion(valor) en el tipo de los elementos
+    template <ExecutionPolicy P, Iterable C, typename Func>
+    requires Addable<std::ranges::range_value_t<C>>
+    auto transform_reduce(const P& politica, C&& contenedor, Func funcion) {
+        CORE_NUMERIC_INSTRUMENT_SCOPE(transform_reduce, contenedor);
+        using T = std::ranges::range_value_t<C>;
+        return core_numeric::transform_reduce(politica, contenedor, T{}, std::plus<T>{}, funcion);
+    }
+
+
+    // sum_variadic
+    //Suma todos los argumentos del pack usando fold expression binaria derecha (...)
+    template <typename... Args>
+    requires (Addable<Args> && ...) // Todos los argumentos deben ser Addable
+    constexpr auto sum_variadic(Args... args) {
+        return (... + args);
+    }
+
+    // mean_variadic
+    // Calcula el promedio aprovechando la función sum_variadic y sizeof... para contar argumentos.
+    template <typename... Args>
+    constexpr auto mean_variadic(Args... args) {
+        auto suma = sum_variadic(args...);
+        if constexpr (std::is_integral_v<decltype(suma)>) {
+            // Los enteros con signo se dividen en su tipo: dividir por size_t los pasaria a sin signo
+            return suma / static_cast<decltype(suma)>(sizeof...(args));
+        } else {
+            return suma / sizeof...(args);
+        }
+    }
+
+
+    // variance_variadic:
+
+    // Para calcular la varianza se necesita recorrer los datos dos veces (una para el promedio, otra para diferencias)
+    // Como no se puede iterar un parameter pack dos veces facil, se copian los datos
+    // a un std::array en la pila (tamaño fijado por sizeof...) y se reutiliza la función variance generica.
+    // Sin memoria dinamica: el resultado es el mismo que con un vector porque el array tambien es contiguo
+    template <typename T, typename... Args>
+    requires Addable<T> && detail::Averageable<T>
+    constexpr auto variance_variadic(T first, Args... args) {
+        std::array<T, 1 + sizeof...(Args)> datos{first, args...};
+        return variance(datos);
+    }
+
+    // max_variadic
+    // Maximo de N argumentos usando fold expressions
+
+    // Usamos una funcion auxiliar para comparar
+    template <typename T>
+    constexpr T max_aux(T a, T b) {
+        return (a > b) ? a : b;
+    }
+
+    template <typename T, typename... Args>
+    requires (Comparable<T> && ... && Comparable<Args>)
+    constexpr T max_variadic(T first, Args... rest) {
+        T max_val = first;
+        // Fold expression con operador coma para actualizar max_val
+        ((max_val = max_aux(max_val, rest)), ...);
+        return max_val;
+    }
+
+
+    // ACUMULADORES EN LINEA:
+
+    namespace detail {
+
+        // Miembro vacio para los estados que un tipo no necesita
+        struct vacio {};
+    } // namespace detail
+
+    // accumulator: recibe los datos de a uno (telemetria, streams) sin guardarlos.
+    // La memoria es constante sin importar cuantos valores lleguen y todas las consultas son O(1).
+    // Las consultas disponibles dependen de los mismos concepts que los algoritmos:
+    // mean necesita Divisible, variance ademas - y *, min/max necesitan Comparable.
+    //
+    // Su estado (cantidad, suma, media, M2, minimo y maximo) es ademas un resumen combinable:
+    // merge junta dos acumuladores como si hubieran visto los datos concatenados, asi que
+    // los parciales de hilos, procesos o archivos distintos se combinan en cualquier orden de arbol.
+    // Para tipos nativos el acumulador es trivialmente copiable y se puede escribir a disco tal cual
+    template <typename T>
+    requires Addable<T>
+    class accumulator {
+        // Que estado extra se lleva para la varianza: momentos de Welford o suma de cuadrados (enteros)
+        static constexpr bool con_momentos = detail::Welfordable<T> && !std::is_integral_v<T>;
+        static constexpr bool con_cuadrados = std::is_integral_v<T>;
+
+    public:
+        using value_type = T;
+        using sum_type = accumulation_t<T>;     // la suma se lleva ensanchada, como en sum
+
+        // Agrega un valor
+        constexpr void push(const T& x) {
+            if constexpr (Comparable<T>) {
+                if (es_nan(x)) {
+                    if (n_ == 0) primero_nan_ = true;
+                } else {
+                    extremos(x, x);
+                }
+            }
+            ++n_;
+            suma_ = suma_ + static_cast<sum_type>(x);
+            if constexpr (con_momentos) {
+                momentos_.push(x);
+            } else if constexpr (con_cuadrados) {
+                cuadrados_ += detail::square_of(x);
+            }
+        }
+
+        // Agrega un bloque de valores contiguos. En los tipos nativos usa los kernels SIMD por bloques de L1:
+        // el bloque se lee una vez desde memoria y las demas pasadas de los kernels lo encuentran en cache
+        constexpr void push(std::span<const T> valores) {
+            if constexpr (detail::SimdSummable<T>) {
+                if (std::is_constant_evaluated()) {
+                    for (const auto& x : valores) {
+                        push(x);
+                    }
+                    return;
+                }
+                constexpr std::size_t bloque = detail::bloque_l1<T>;
+                for (std::size_t i = 0; i < valores.size(); i += bloque) {
+                    const std::size_t cantidad = valores.size() - i < bloque ? valores.size() - i : bloque;
+                    const T* datos = valores.data() + i;
+                    // Los kernels propagan un NaN en la primera posicion del bloque: se saltan los NaN iniciales
+                    // para no perder los extremos del resto del bloque
+                    std::size_t salto = 0;
+                    while (salto < cantidad && es_nan(datos[salto])) ++salto;
+                    if (n_ == 0 && salto > 0) primero_nan_ = true;
+                    if (salto < cantidad) {
+                        extremos(detail::min_kernel(datos + salto, cantidad - salto),
+                                 detail::max_kernel(datos + salto, cantidad - salto));
+                    }
+                    n_ += cantidad;
+                    if constexpr (con_momentos) {
+                        suma_ = suma_ + momentos_.push_block(datos, cantidad);
+                    } else {
+                        if constexpr (detail::WideSummable<T>) {
+                            suma_ = suma_ + detail::wide_sum_kernel(datos, cantidad);
+                        } else {
+                            suma_ = suma_ + detail::sum_kernel(datos, cantidad);
+                        }
+                        cuadrados_ += detail::sum_squares_kernel(datos, cantidad);
+                    }
+                }
+            } else {
+                for (const auto& x : valores) {
+                    push(x);
+                }
+            }
+        }
+
+        // Combina con el estado de otro acumulador, como si sus datos vinieran despues de los nuestros.
+        // Enteros: todo son sumas (la de cuadrados modulo 2^128), minimos y maximos, asi que es exacto y asociativo.
+        // Punto flotante: la media y M2 se combinan con la formula de Chan, que es estable.
+        // Los tipos de usuario con varianza no se pueden combinar: Chan necesita multiplicar por un escalar
+        constexpr void merge(const accumulator& otro) requires (!con_momentos || std::floating_point<T>) {
+            if (otro.n_ == 0) return;
+            if (n_ == 0) {
+                *this = otro;
+                return;
+            }
+            if constexpr (Comparable<T>) {
+                if (otro.con_extremos_) extremos(otro.minimo_, otro.maximo_);
+            }
+            n_ += otro.n_;
+            suma_ = suma_ + otro.suma_;
+            if constexpr (con_momentos) {
+                momentos_.merge(otro.momentos_);
+            } else if constexpr (con_cuadrados) {
+                cuadrados_ += otro.cuadrados_;
+            }
+        }
+
+        constexpr std::size_t count() const { return n_; }
+
+        constexpr sum_type sum() const { return suma_; }
+
+        constexpr auto mean() const requires detail::Averageable<T> {
+            return detail::mean_of_sum<T>(suma_, n_);
+        }
+
+        // Suma de cuadrados de las desviaciones respecto a la media.
+        // Flotantes y tipos de usuario la llevan con Welford/Chan;
+        // los enteros la derivan exacta de la suma y la suma de cuadrados (truncada, en 128 bits sin signo)
+        constexpr auto m2() const requires con_momentos || con_cuadrados {
+            if constexpr (con_momentos) {
+                return n_ == 0 ? T{} : momentos_.m2;
+            } else {
+                return detail::integer_m2<T>(n_, suma_, cuadrados_);
+            }
+        }
+
+        // Varianza poblacional. En enteros es exacta y truncada, en el tipo de acumulacion:
+        // no se trunca la media antes de tiempo (ver detail::integer_variance)
+        constexpr auto variance() const requires con_momentos || con_cuadrados {
+            if constexpr (con_momentos) {
+                return n_ == 0 ? T{} : momentos_.m2 / n_;
+            } else {
+                return detail::integer_variance<T>(n_, suma_, cuadrados_);
+            }
+        }
+
+        // Minimo y maximo, con la misma semantica que max: solo un NaN en el primer valor se propaga
+        constexpr T min() const requires Comparable<T> {
+            if constexpr (std::floating_point<T>) {
+                if (primero_nan_) return std::numeric_limits<T>::quiet_NaN();
+            }
+            return minimo_;
+        }
+
+        constexpr T max() const requires Comparable<T> {
+            if constexpr (std::floating_point<T>) {
+                if (primero_nan_) return std::numeric_limits<T>::quiet_NaN();
+            }
+            return maximo_;
+        }
+
+    private:
+        static constexpr bool es_nan(const T& x) {
+            if constexpr (std::floating_point<T>) {
+                return x != x;
+            } else {
+                return false;
+            }
+        }
+
+        // Los extremos se llevan sin NaN, asi un resumen combinado no pierde los valores
+        // que vienen despues de un NaN; primero_nan_ recuerda si el primer valor de la serie lo era
+        constexpr void extremos(const T& menor, const T& mayor) requires Comparable<T> {
+            if (!con_extremos_) {
+                minimo_ = menor;
+                maximo_ = mayor;
+                con_extremos_ = true;
+                return;
+            }
+            if (mayor > maximo_) maximo_ = mayor;
+            if (minimo_ > menor) minimo_ = menor;
+        }
+
+        std::size_t n_ = 0;
+        sum_type suma_{};
+        T minimo_{};
+        T maximo_{};
+        bool con_extremos_ = false;
+        bool primero_nan_ = false;
+        [[no_unique_address]] std::conditional_t<con_momentos, detail::moments<T>, detail::vacio> momentos_{};
+        [[no_unique_address]] std::conditional_t<con_cuadrados, detail::square_sum_t, detail::vacio> cuadrados_{};
+    };
+
+    // El estado de un accumulator es el resumen combinable de una serie
+    template <typename T>
+    using summary = accumulator<T>;
+
+    // merge(a, b): resumen de la concatenacion de las dos series
+    template <typename T>
+    constexpr accumulator<T> merge(accumulator<T> a, const accumulator<T>& b) requires requires { a.merge(b); } {
+        a.merge(b);
+        return a;
+    }
+
+    // Resumen de un contenedor completo. Los contiguos de tipos nativos van por bloques SIMD
+    template <Iterable C>
+    requires Addable<std::ranges::range_value_t<C>>
+    constexpr auto summarize(C&& contenedor) {
+        CORE_NUMERIC_INSTRUMENT_SCOPE(summarize, contenedor);
+        using T = std::ranges::range_value_t<C>;
+        summary<T> resumen;
+        if constexpr (std::ranges::contiguous_range<C> && std::ranges::sized_range<C>) {
+            resumen.push(std::span<const T>(std::ranges::data(contenedor), std::ranges::size(contenedor)));
+        } else {
+            for (const auto& valor : contenedor) {
+                resumen.push(valor);
+            }
+        }
+        return resumen;
+    }
+
+    // Resumen en paralelo: cada hilo resume su trozo y los parciales se combinan en arbol con merge
+    template <ExecutionPolicy P, Iterable C>
+    requires Addable<std::ranges::range_value_t<C>>
+    auto summarize(const P& politica, C&& contenedor) {
+        CORE_NUMERIC_INSTRUMENT_SCOPE(summarize, contenedor);
+        using T = std::ranges::range_value_t<C>;
+        if constexpr (std::same_as<std::remove_cvref_t<P>, execution::sequenced_policy> || !detail::Splittable<C>
+                      || !requires (summary<T> a, const summary<T>& b) { a.merge(b); }) {
+            return summarize(contenedor);
+        } else {
+            const std::size_t n = std::ranges::size(contenedor);
+            unsigned hilos = detail::thread_count(politica, n);
+            if (hilos <= 1) return summarize(contenedor);
+
+            auto parciales = detail::run_chunks<summary<T>>(n, hilos, [&](unsigned, std::size_t desde, std::size_t hasta) {
+                return summarize(detail::make_slice(contenedor, desde, hasta));
+            }, detail::chunk_granule(contenedor));
+            return detail::tree_combine(std::move(parciales), [](summary<T> a, const summary<T>& b) {
+                a.merge(b);
+                return a;
+            });
+        }
+    }
+
+    // DESCRIPCION EN UNA PASADA:
+
+    namespace detail {
+
+        // Partes de description: cada grupo de campos existe solo si el tipo lo permite
+        template <typename T, bool>
+        struct campos_media {};
+
+        template <typename T>
+        struct campos_media<T, true> {
+            T mean{};
+        };
+
+        template <typename V, bool>
+        struct campos_varianza {};
+
+        template <typename V>
+        struct campos_varianza<V, true> {
+            V variance{};
+        };
+
+        template <typename T, bool>
+        struct campos_extremos {};
+
+        template <typename T>
+        struct campos_extremos<T, true> {
+            T min{};
+            T max{};
+        };
+
+        template <typename T>
+        concept con_varianza = requires (const accumulator<T>& a) { a.variance(); };
+    } // namespace detail
+
+    // Resultado de describe: count y sum siempre, mean si el tipo es Divisible (o entero),
+    // variance si ademas tiene - y *, min/max si es Comparable.
+    // sum y variance usan los mismos tipos que los algoritmos: la suma de enteros va ensanchada
+    template <typename T>
+    requires Addable<T>
+    struct description : detail::campos_media<T, detail::Averageable<T>>,
+                         detail::campos_varianza<detail::variance_type<T>, detail::con_varianza<T>>,
+                         detail::campos_extremos<T, Comparable<T>> {
+        std::size_t count = 0;
+        accumulation_t<T> sum{};
+    };
+
+    namespace detail {
+
+        template <typename T>
+        constexpr description<T> describe_summary(const summary<T>& resumen) {
+            description<T> resultado;
+            resultado.count = resumen.count();
+            resultado.sum = resumen.sum();
+            if constexpr (detail::Averageable<T>) {
+                resultado.mean = resumen.mean();
+            }
+            if constexpr (con_varianza<T>) {
+                resultado.variance = resumen.variance();
+            }
+            if constexpr (Comparable<T>) {
+                resultado.min = resumen.min();
+                resultado.max = resumen.max();
+            }
+            return resultado;
+        }
+    } // namespace detail
+
+    // describe: count, sum, mean, variance, min y max en una sola lectura de los datos.
+    // Llamar a sum, mean, variance y max por separado recorre la memoria hasta cinco veces;
+    // aqui los contenedores contiguos se procesan por bloques de L1 con todos los kernels SIMD sobre el mismo bloque
+    template <Iterable C>
+    requires Addable<std::ranges::range_value_t<C>>
+    constexpr auto describe(C&& contenedor) {
+        CORE_NUMERIC_INSTRUMENT_SCOPE(describe, contenedor);
+        return detail::describe_summary(summarize(contenedor));
+    }
+
+    // describe con politica de ejecucion: resumen por trozos combinado con merge
+    template <ExecutionPolicy P, Iterable C>
+    requires Addable<std::ranges::range_value_t<C>>
+    auto describe(const P& politica, C&& contenedor) {
+        CORE_NUMERIC_INSTRUMENT_SCOPE(describe, contenedor);
+        return detail::describe_summary(summarize(politica, contenedor));
+    }
+
+    // LOTES DE SERIES:
+
+    namespace detail {
+
+        // Un lote es un rango de series (por ejemplo std::vector<std::vector<double>>)
+        template <typename R>
+        using serie_t = std::ranges::range_value_t<R>;
+
+        template <typename R>
+        using valor_serie_t = std::ranges::range_value_t<serie_t<R>>;
+
+        // Elementos de una serie para repartir el trabajo; sin tamaño conocido cuenta como 1
+        template <typename S>
+        std::size_t largo_serie(const S& serie) {
+            if constexpr (std::ranges::sized_range<const S>) {
+                return static_cast<std::size_t>(std::ranges::size(serie));
+            } else {
+                return 1;
+            }
+        }
+
+        // Unidad de trabajo de un lote: varias series chicas enteras [primera, ultima), o el trozo
+        // [desde, hasta) de una serie grande, cuyo resumen parcial va a piezas[pieza]
+        struct trabajo_lote {
+            std::size_t primera = 0;
+            std::size_t ultima = 0;
+            std::size_t desde = 0;
+            std::size_t hasta = 0;
+            std::size_t pieza = std::numeric_limits<std::size_t>::max();
+        };
+
+        // Elementos por unidad de trabajo: las series mas grandes se parten y las mas chicas se agrupan
+        // hasta juntar unos 32k, unos microsegundos de trabajo, asi robar una unidad compensa su costo
+        inline constexpr std::size_t grano_lote = std::size_t{1} << 15;
+
+        // Cola de un hilo en el planificador de lotes. Las unidades ya estan en un arreglo, asi que la cola
+        // es un intervalo [cabeza, cola) en una sola palabra atomica: el dueño toma por la cabeza, en orden
+        // (las series vecinas suelen estar cerca en memoria), y los ladrones por la cola. Los dos mueven
+        // la palabra con compare_exchange, asi nunca se entrega una unidad dos veces
+        struct cola_robo {
+            alignas(64) std::atomic<std::uint64_t> intervalo{0};
+
+            void llenar(std::uint32_t cabeza, std::uint32_t cola) {
+                intervalo.store((std::uint64_t{cabeza} << 32) | cola, std::memory_order_relaxed);
+            }
+
+            bool tomar(std::uint32_t& unidad) {
+                std::uint64_t actual = intervalo.load(std::memory_order_relaxed);
+                while (true) {
+                    std::uint32_t cabeza = static_cast<std::uint32_t>(actual >> 32);
+                    std::uint32_t cola = static_cast<std::uint32_t>(actual);
+                    if (cabeza >= cola) return false;
+                    if (intervalo.compare_exchange_weak(actual, actual + (std::uint64_t{1} << 32),
+                                                        std::memory_order_relaxed)) {
+                        unidad = cabeza;
+                        return true;
+                    }
+                }
+            }
+
+            bool robar(std::uint32_t& unidad) {
+                std::uint64_t actual = intervalo.load(std::memory_order_relaxed);
+                while (true) {
+                    std::uint32_t cabeza = static_cast<std::uint32_t>(actual >> 32);
+                    std::uint32_t cola = static_cast<std::uint32_t>(actual);
+                    if (cabeza >= cola) return false;
+                    if (intervalo.compare_exchange_weak(actual, actual - 1, std::memory_order_relaxed)) {
+                        unidad = cola - 1;
+                        return true;
+                    }
+                }
+            }
+        };
+
+    } // namespace detail
+
+    // Resume cada serie de un lote, en orden
+    template <Iterable R>
+    requires Iterable<detail::serie_t<R>> && Addable<detail::valor_serie_t<R>>
+    auto summarize_batch(R&& series) {
+        CORE_NUMERIC_INSTRUMENT_SCOPE(summarize_batch, series);
+        using T = detail::valor_serie_t<R>;
+        std::vector<summary<T>> resultados;
+        if constexpr (std::ranges::sized_range<R>) {
+            resultados.reserve(std::ranges::size(series));
+        }
+        for (auto&& serie : series) {
+            resultados.push_back(summarize(serie));
+        }
+        return resultados;
+    }
+
+    // Lote en paralelo, pensado para muchas series independientes de largos muy distintos, donde
+    // repartir cada serie no sirve (son chicas) y repartir las series por hilo queda desbalanceado.
+    // Las series se cortan en unidades de unos grano_lote elementos (las grandes en trozos que se combinan
+    // con merge, las chicas agrupadas), las unidades se reparten por elementos en una cola por hilo y
+    // un hilo que vacia la suya roba de las colas de los demas
+    template <ExecutionPolicy P, Iterable R>
+    requires Iterable<detail::serie_t<R>> && Addable<detail::valor_serie_t<R>>
+    auto summarize_batch(const P& politica, R&& series) {
+        CORE_NUMERIC_INSTRUMENT_SCOPE(summarize_batch, series);
+        using S = detail::serie_t<R>;
+        using T = detail::valor_serie_t<R>;
+        constexpr bool partible = detail::Splittable<const S&> && requires (summary<T> a, const summary<T>& b) { a.merge(b); };
+
+        if constexpr (std::same_as<std::remove_cvref_t<P>, execution::sequenced_policy> || !detail::Splittable<R>) {
+            return summarize_batch(series);
+        } else {
+            const std::size_t cantidad = std::ranges::size(series);
+            auto serie = [&](std::size_t i) -> decltype(auto) { return std::ranges::begin(series)[i]; };
+
+            // Unidades de trabajo
+            std::vector<detail::trabajo_lote> unidades;
+            std::vector<std::size_t> elementos;  // Elementos de cada unidad, para repartir
+            std::size_t total = 0;
+            std::size_t piezas = 0;
+            for (std::size_t i = 0; i < cantidad;) {
+                std::size_t largo = detail::largo_serie(serie(i));
+                if (partible && largo >= 2 * detail::grano_lote) {
+                    const std::size_t granulo = detail::chunk_granule(serie(i));
+                    const std::size_t trozos = largo / detail::grano_lote;
+                    for (std::size_t t = 0; t < trozos; ++t) {
+                        std::size_t desde = t == 0 ? 0 : largo * t / trozos / granulo * granulo;
+                        std::size_t hasta = t + 1 == trozos ? largo : largo * (t + 1) / trozos / granulo * granulo;
+                        unidades.push_back({i, i + 1, desde, hasta, piezas++});
+                        elementos.push_back(hasta - desde);
+                    }
+                    total += largo;
+                    ++i;
+                    continue;
+                }
+                // Agrupa series chicas hasta llegar al grano (o a una serie que se va a partir)
+                std::size_t primera = i;
+                std::size_t juntos = 0;
+                while (i < cantidad && juntos < detail::grano_lote) {
+                    std::size_t siguiente = detail::largo_serie(serie(i));
+                    if (partible && siguiente >= 2 * detail::grano_lote) break;
+                    juntos += siguiente;
+                    ++i;
+                }
+                unidades.push_back({primera, i, 0, 0, std::numeric_limits<std::size_t>::max()});
+                elementos.push_back(juntos);
+                total += juntos;
+            }
+
+            unsigned hilos = detail::thread_count(politica, total);
+            if (hilos > unidades.size()) hilos = static_cast<unsigned>(unidades.size());
+            if (hilos <= 1 || unidades.size() > std::numeric_limits<std::uint32_t>::max()) {
+                return summarize_batch(series);
+            }
+
+            // Cada cola empieza con un bloque contiguo de unidades con la misma cantidad de elementos
+            std::vector<detail::cola_robo> colas(hilos);
+            std::size_t unidad = 0;
+            std::size_t acumulado = 0;
+            for (unsigned k = 0; k < hilos; ++k) {
+                std::size_t inicio = unidad;
+                const std::size_t meta = total / hilos * (k + 1);
+                while (unidad < unidades.size() && (k + 1 == hilos || acumulado < meta)) {
+                    acumulado += elementos[unidad++];
+                }
+                colas[k].llenar(static_cast<std::uint32_t>(inicio), static_cast<std::uint32_t>(unidad));
+            }
+
+            std::vector<summary<T>> resultados(cantidad);
+            std::vector<summary<T>> parciales(piezas);
+            auto procesar = [&](const detail::trabajo_lote& trabajo) {
+                if (trabajo.pieza != std::numeric_limits<std::size_t>::max()) {
+                    if constexpr (partible) {
+                        parciales[trabajo.pieza] = summarize(detail::make_slice(serie(trabajo.primera), trabajo.desde, trabajo.hasta));
+                    }
+                } else {
+                    for (std::size_t i = trabajo.primera; i < trabajo.ultima; ++i) {
+                        resultados[i] = summarize(serie(i));
+                    }
+                }
+            };
+
+            // Cada tarea de run_chunks es un hilo del planificador: vacia su cola y despues roba
+            detail::run_chunks<char>(hilos, hilos, [&](unsigned k, std::size_t, std::size_t) {
+                std::uint32_t u = 0;
+                while (colas[k].tomar(u)) {
+                    procesar(unidades[u]);
+                }
+                for (unsigned paso = 1; paso < hilos; ++paso) {
+                    auto& victima = colas[(k + paso) % hilos];
+                    while (victima.robar(u)) {
+                        procesar(unidades[u]);
+                    }
+                }
+                return char{};
+            });
+
+            // Las series partidas se combinan en orden, trozo por trozo
+            if constexpr (partible) {
+                for (const auto& trabajo : unidades) {
+                    if (trabajo.pieza == std::numeric_limits<std::size_t>::max()) continue;
+                    if (trabajo.desde == 0) {
+                        resultados[trabajo.primera] = parciales[trabajo.pieza];
+                    } else {
+                        resultados[trabajo.primera].merge(parciales[trabajo.pieza]);
+                    }
+                }
+            }
+            return resultados;
+        }
+    }
+
+    // describe de cada serie de un lote
+    template <Iterable R>
+    requires Iterable<detail::serie_t<R>> && Addable<detail::valor_serie_t<R>>
+    auto describe_batch(R&& series) {
+        CORE_NUMERIC_INSTRUMENT_SCOPE(describe_batch, series);
+        using T = detail::valor_serie_t<R>;
+        auto resumenes = summarize_batch(series);
+        std::vector<description<T>> resultados;
+        resultados.reserve(resumenes.size());
+        for (const auto& resumen : resumenes) {
+            resultados.push_back(detail::describe_summary(resumen));
+        }
+        return resultados;
+    }
+
+    // describe de cada serie de un lote con el planificador de summarize_batch
+    template <ExecutionPolicy P, Iterable R>
+    requires Iterable<detail::serie_t<R>> && Addable<detail::valor_serie_t<R>>
+    auto describe_batch(const P& politica, R&& series) {
+        CORE_NUMERIC_INSTRUMENT_SCOPE(describe_batch, series);
+        using T = detail::valor_serie_t<R>;
+        auto resumenes = summarize_batch(politica, series);
+        std::vector<description<T>> resultados;
+        resultados.reserve(resumenes.size());
+        for (const auto& resumen : resumenes) {
+            resultados.push_back(detail::describe_summary(resumen));
+        }
+        return resultados;
+    }
+
+    // TUBERIAS PEREZOSAS:
+
+    namespace detail {
+
+        // Etapas de una tuberia. Se guardan por valor y se aplican en orden a cada elemento
+        template <typename F>
+        struct map_stage {
+            F funcion;
+        };
+
+        template <typename F>
+        struct filter_stage {
+            F predicado;
+        };
+
+        template <typename E>
+        inline constexpr bool is_map_stage = false;
+
+        template <typename F>
+        inline constexpr bool is_map_stage<map_stage<F>> = true;
+
+        // Tipo que sale de una etapa cuando entra un V: los filtros no lo cambian
+        template <typename V, typename Etapa>
+        struct stage_output {
+            using type = V;
+        };
+
+        template <typename V, typename F>
+        struct stage_output<V, map_stage<F>> {
+            using type = std::remove_cvref_t<std::invoke_result_t<const F&, const V&>>;
+        };
+
+        // Tipo que sale de la tuberia completa
+        template <typename V, typename... Etapas>
+        struct pipeline_value {
+            using type = V;
+        };
+
+        template <typename V, typename Etapa, typename... Resto>
+        struct pipeline_value<V, Etapa, Resto...> : pipeline_value<typename stage_output<V, Etapa>::type, Resto...> {};
+
+        // Pasa un valor por las etapas I, I+1, ... y lo entrega a destino si supera todos los filtros.
+        // Se instancia entera para cada tuberia, asi el compilador ve un solo cuerpo de bucle sin llamadas indirectas
+        template <std::size_t I, typename Etapas, typename V, typename Destino>
+        constexpr void push_through(const Etapas& etapas, const V& valor, Destino& destino) {
+            if constexpr (I == std::tuple_size_v<Etapas>) {
+                destino(valor);
+            } else {
+                const auto& etapa = std::get<I>(etapas);
+                if constexpr (is_map_stage<std::remove_cvref_t<decltype(etapa)>>) {
+                    push_through<I + 1>(etapas, std::invoke(etapa.funcion, valor), destino);
+                } else {
+                    if (std::invoke(etapa.predicado, valor)) {
+                        push_through<I + 1>(etapas, valor, destino);
+                    }
+                }
+            }
+        }
+    } // namespace detail
+
+    // pipeline: from(v).filter(p).map(f) arma la tuberia sin recorrer nada; recien la operacion final
+    // (sum, mean, variance, min, max, count, summarize, describe) recorre la fuente, una sola vez,
+    // con todas las etapas fusionadas en el mismo bucle y sin vectores intermedios.
+    // Si los valores que salen tienen kernel SIMD (float, double, int32, int64), se juntan en un bloque
+    // del tamaño de L1 en la pila y cada bloque se reduce con los mismos kernels que los algoritmos;
+    // si no, se reducen de a uno. Los tipos se verifican con los mismos concepts que los algoritmos
+    template <std::ranges::view R, typename... Etapas>
+    class pipeline {
+    public:
+        using value_type = typename detail::pipeline_value<std::ranges::range_value_t<R>, Etapas...>::type;
+
+        constexpr pipeline(R fuente, std::tuple<Etapas...> etapas)
+            : fuente_(std::move(fuente)), etapas_(std::move(etapas)) {}
+
+        // Transformacion: cada valor x pasa a ser funcion(x)
+        template <typename F>
+        requires std::invocable<const F&, const value_type&>
+              && (!std::is_void_v<std::invoke_result_t<const F&, const value_type&>>)
+        constexpr auto map(F funcion) const& requires std::copy_constructible<R> {
+            return agregar(*this, detail::map_stage<F>{std::move(funcion)});
+        }
+
+        template <typename F>
+        requires std::invocable<const F&, const value_type&>
+              && (!std::is_void_v<std::invoke_result_t<const F&, const value_type&>>)
+        constexpr auto map(F funcion) && {
+            return agregar(std::move(*this), detail::map_stage<F>{std::move(funcion)});
+        }
+
+        // Filtro: solo siguen los valores con predicado(x) verdadero
+        template <typename F>
+        requires std::predicate<const F&, const value_type&>
+        constexpr auto filter(F predicado) const& requires std::copy_constructible<R> {
+            return agregar(*this, detail::filter_stage<F>{std::move(predicado)});
+        }
+
+        template <typename F>
+        requires std::predicate<const F&, const value_type&>
+        constexpr auto filter(F predicado) && {
+            return agregar(std::move(*this), detail::filter_stage<F>{std::move(predicado)});
+        }
+
+        // Entrega cada valor que sale de la tuberia a destino
+        template <typename Destino>
+        requires std::invocable<Destino&, const value_type&>
+        constexpr void for_each(Destino destino) {
+            for (auto&& valor : fuente_) {
+                detail::push_through<0>(etapas_, valor, destino);
+            }
+        }
+
+        constexpr std::size_t count() {
+            std::size_t n = 0;
+            recorrer([&](const value_type&) { ++n; }, [&](std::span<const value_type> bloque) { n += bloque.size(); });
+            return n;
+        }
+
+        // Suma ensanchada, como sum
+        constexpr auto sum() requires Addable<value_type> {
+            return sum_and_count().first;
+        }
+
+        constexpr auto mean() requires detail::Averageable<value_type> && Addable<value_type> {
+            auto [suma, n] = sum_and_count();
+            return detail::mean_of_sum<value_type>(suma, n);
+        }
+
+        // variance, min y max salen del resumen de una pasada (con los kernels por bloque)
+        constexpr auto variance() requires Addable<value_type> && detail::con_varianza<value_type> {
+            return summarize().variance();
+        }
+
+        constexpr value_type min() requires Addable<value_type> && Comparable<value_type> {
+            return summarize().min();
+        }
+
+        constexpr value_type max() requires Addable<value_type> && Comparable<value_type> {
+            return summarize().max();
+        }
+
+        constexpr summary<value_type> summarize() requires Addable<value_type> {
+            summary<value_type> resumen;
+            recorrer([&](const value_type& valor) { resumen.push(valor); },
+                     [&](std::span<const value_type> bloque) { resumen.push(bloque); });
+            return resumen;
+        }
+
+        constexpr description<value_type> describe() requires Addable<value_type> {
+            return detail::describe_summary(summarize());
+        }
+
+    private:
+        template <std::ranges::view, typename...>
+        friend class pipeline;
+
+        template <typename Self, typename Etapa>
+        static constexpr auto agregar(Self&& self, Etapa etapa) {
+            return pipeline<R, Etapas..., Etapa>(std::forward<Self>(self).fuente_,
+                                                 std::tuple_cat(std::forward<Self>(self).etapas_, std::tuple<Etapa>(std::move(etapa))));
+        }
+
+        // Recorre la fuente una vez. Con tipos SIMD los valores se juntan en un bloque de L1 en la pila
+        // y se entregan a 'bloque'; en otro caso, o en evaluacion constante, se entregan de a uno a 'elemento'
+        template <typename Elemento, typename Bloque>
+        constexpr void recorrer(Elemento elemento, Bloque bloque) {
+            if constexpr (detail::SimdSummable<value_type>) {
+                if (!std::is_constant_evaluated()) {
+                    constexpr std::size_t capacidad = detail::bloque_l1<value_type>;
+                    value_type buffer[capacidad];
+                    std::size_t usados = 0;
+                    auto guardar = [&](const value_type& valor) {
+                        buffer[usados++] = valor;
+                        if (usados == capacidad) {
+                            bloque(std::span<const value_type>(buffer, usados));
+                            usados = 0;
+                        }
+                    };
+                    for_each(guardar);
+                    if (usados > 0) bloque(std::span<const value_type>(buffer, usados));
+                    return;
+                }
+            }
+            for_each(elemento);
+        }
+
+        constexpr auto sum_and_count() {
+            using A = accumulation_t<value_type>;
+            A suma{};
+            std::size_t n = 0;
+            recorrer([&](const value_type& valor) {
+                         suma = suma + static_cast<A>(valor);
+                         ++n;
+                     },
+                     [&](std::span<const value_type> bloque) {
+                         if constexpr (detail::WideSummable<value_type>) {
+                             suma = suma + detail::wide_sum_kernel(bloque.data(), bloque.size());
+                         } else if constexpr (detail::SimdSummable<value_type>) {
+                             suma = suma + detail::sum_kernel(bloque.data(), bloque.size());
+                         }
+                         n += bloque.size();
+                     });
+            return std::pair<A, std::size_t>{suma, n};
+        }
+
+        R fuente_;
+        std::tuple<Etapas...> etapas_;
+    };
+
+    // Punto de entrada de las tuberias. Los contenedores se toman por referencia (std::views::all)
+    // y los temporales se mueven adentro de la tuberia, nunca se copian los datos
+    template <Iterable C>
+    requires std::ranges::viewable_range<C>
+    constexpr auto from(C&& contenedor) {
+        using R = std::views::all_t<C>;
+        return pipeline<R>(std::views::all(std::forward<C>(contenedor)), std::tuple<>{});
+    }
+
+    // ESTRUCTURA DE ARREGLOS:
+
+    namespace detail {
+
+        // Clase y tipo del miembro apuntado por un puntero a miembro (double Vector3D::* -> Vector3D, double)
+        template <typename P>
+        struct member_traits;
+
+        template <typename C, typename M>
+        struct member_traits<M C::*> {
+            using clase = C;
+            using tipo = M;
+        };
+
+        template <auto Miembro>
+        using member_t = typename member_traits<decltype(Miembro)>::tipo;
+    } // namespace detail
+
+    // soa_vector: guarda cada componente de T en su propio vector contiguo (estructura de arreglos).
+    // soa_vector<Vector3D, &Vector3D::x, &Vector3D::y, &Vector3D::z> tiene tres columnas de double,
+    // asi sum, mean, variance y max se calculan componente a componente con los kernels SIMD
+    // en vez de recorrer structs y crear un temporal por elemento con operator+.
+    // T solo necesita constructor por defecto y miembros publicos; los elementos se reconstruyen al leerlos
+    template <typename T, auto... Miembros>
+    requires (sizeof...(Miembros) > 0) && std::default_initializable<T>
+          && (std::same_as<typename detail::member_traits<decltype(Miembros)>::clase, T> && ...)
+    class soa_vector {
+    public:
+        using value_type = T;
+        static constexpr std::size_t components = sizeof...(Miembros);
+
+        // Tipo del componente I
+        template <std::size_t I>
+        using component_type = std::tuple_element_t<I, std::tuple<detail::member_t<Miembros>...>>;
+
+        soa_vector() = default;
+
+        soa_vector(std::initializer_list<T> valores) {
+            reserve(valores.size());
+            for (const auto& valor : valores) {
+                push_back(valor);
+            }
+        }
+
+        // Copia un rango de structs (array de estructuras) a columnas
+        template <Iterable C>
+        requires std::same_as<std::ranges::range_value_t<C>, T>
+        explicit soa_vector(C&& contenedor) {
+            if constexpr (std::ranges::sized_range<C>) {
+                reserve(std::ranges::size(contenedor));
+            }
+            for (const auto& valor : contenedor) {
+                push_back(valor);
+            }
+        }
+
+        void push_back(const T& valor) {
+            por_componente([&]<std::size_t I>() { std::get<I>(columnas_).push_back(valor.*std::get<I>(miembros)); });
+        }
+
+        // Reconstruye el elemento i
+        T operator[](std::size_t i) const {
+            T valor{};
+            por_componente([&]<std::size_t I>() { valor.*std::get<I>(miembros) = std::get<I>(columnas_)[i]; });
+            return valor;
+        }
+
+        void set(std::size_t i, const T& valor) {
+            por_componente([&]<std::size_t I>() { std::get<I>(columnas_)[i] = valor.*std::get<I>(miembros); });
+        }
+
+        std::size_t size() const { return std::get<0>(columnas_).size(); }
+        bool empty() const { return size() == 0; }
+
+        void reserve(std::size_t n) {
+            por_componente([&]<std::size_t I>() { std::get<I>(columnas_).reserve(n); });
+        }
+
+        void resize(std::size_t n) {
+            por_componente([&]<std::size_t I>() { std::get<I>(columnas_).resize(n); });
+        }
+
+        void clear() {
+            por_componente([&]<std::size_t I>() { std::get<I>(columnas_).clear(); });
+        }
+
+        // Columna contigua del componente I, para pasarla a cualquier algoritmo
+        template <std::size_t I>
+        std::span<const component_type<I>> component() const {
+            return std::get<I>(columnas_);
+        }
+
+        template <std::size_t I>
+        std::span<component_type<I>> component() {
+            return std::get<I>(columnas_);
+        }
+
+        static constexpr std::tuple<decltype(Miembros)...> miembros{Miembros...};
+
+    private:
+        template <typename F>
+        static void por_componente(F&& funcion) {
+            [&]<std::size_t... I>(std::index_sequence<I...>) {
+                (funcion.template operator()<I>(), ...);
+            }(std::make_index_sequence<components>{});
+        }
+
+        std::tuple<std::vector<detail::member_t<Miembros>>...> columnas_;
+    };
+
+    namespace detail {
+
+        // Arma un T con reducir(columna) en cada componente
+        template <typename T, auto... Miembros, typename F>
+        T reduce_components(const soa_vector<T, Miembros...>& soa, F reducir) {
+            using S = soa_vector<T, Miembros...>;
+            T resultado{};
+            [&]<std::size_t... I>(std::index_sequence<I...>) {
+                ((resultado.*std::get<I>(S::miembros) =
+                      static_cast<typename S::template component_type<I>>(reducir(soa.template component<I>()))), ...);
+            }(std::make_index_sequence<S::components>{});
+            return resultado;
+        }
+    } // namespace detail
+
+    // Algoritmos sobre soa_vector: cada componente se reduce por separado con el kernel de su tipo
+    // y el resultado se devuelve como T. La suma de enteros se ensancha por columna y se convierte al tipo del miembro
+    template <typename T, auto... Miembros>
+    T sum(const soa_vector<T, Miembros...>& soa) {
+        return detail::reduce_components(soa, [](const auto& columna) { return sum(columna); });
+    }
+
+    template <typename T, auto... Miembros>
+    requires (detail::Averageable<detail::member_t<Miembros>> && ...)
+    T mean(const soa_vector<T, Miembros...>& soa) {
+        return detail::reduce_components(soa, [](const auto& columna) { return mean(columna); });
+    }
+
+    template <typename T, auto... Miembros>
+    requires (detail::Averageable<detail::member_t<Miembros>> && ...)
+    T variance(const soa_vector<T, Miembros...>& soa) {
+        return detail::reduce_components(soa, [](const auto& columna) { return variance(columna); });
+    }
+
+    // Maximo componente a componente (la esquina superior de la caja que contiene a todos los puntos).
+    // No usa el operator> de T: cada componente puede venir de un elemento distinto
+    template <typename T, auto... Miembros>
+    requires (Comparable<detail::member_t<Miembros>> && ...)
+    T max(const soa_vector<T, Miembros...>& soa) {
+        return detail::reduce_components(soa, [](const auto& columna) { return max(columna); });
+    }
+
+    // Versiones con politica de ejecucion: cada columna se reparte entre los hilos
+    template <ExecutionPolicy P, typename T, auto... Miembros>
+    T sum(const P& politica, const soa_vector<T, Miembros...>& soa) {
+        return detail::reduce_components(soa, [&](const auto& columna) { return sum(politica, columna); });
+    }
+
+    template <ExecutionPolicy P, typename T, auto... Miembros>
+    requires (detail::Averageable<detail::member_t<Miembros>> && ...)
+    T mean(const P& politica, const soa_vector<T, Miembros...>& soa) {
+        return detail::reduce_components(soa, [&](const auto& columna) { return mean(politica, columna); });
+    }
+
+    template <ExecutionPolicy P, typename T, auto... Miembros>
+    requires (detail::Averageable<detail::member_t<Miembros>> && ...)
+    T variance(const P& politica, const soa_vector<T, Miembros...>& soa) {
+        return detail::reduce_components(soa, [&](const auto& columna) { return variance(politica, columna); });
+    }
+
+    template <ExecutionPolicy P, typename T, auto... Miembros>
+    requires (Comparable<detail::member_t<Miembros>> && ...)
+    T max(const P& politica, const soa_vector<T, Miembros...>& soa) {
+        return detail::reduce_components(soa, [&](const auto& columna) { return max(politica, columna); });
+    }
+
+    // COLUMNAS EN DISCO:
+
+#if CORE_NUMERIC_POSIX
+    namespace detail {
+
+        // Menor numero de T que ocupa un multiplo exacto del tamaño de pagina
+        template <typename T>
+        std::size_t page_granule() noexcept {
+            long consulta = ::sysconf(_SC_PAGESIZE);
+            const std::size_t pagina = consulta > 0 ? static_cast<std::size_t>(consulta) : 4096;
+            std::size_t bytes = pagina;
+            while (bytes % sizeof(T) != 0) {
+                bytes += pagina;
+            }
+            return bytes / sizeof(T);
+        }
+    } // namespace detail
+
+    // mapped_column: archivo binario crudo de T (little-endian, sin cabecera) mapeado con mmap.
+    // Es un rango contiguo de solo lectura, asi que entra en todos los algoritmos sin copiar nada a un
+    // vector, usa los kernels SIMD y se reparte entre hilos con las politicas de ejecucion.
+    // El sistema operativo trae las paginas a medida que se leen, por eso sirve para archivos mas
+    // grandes que la RAM. Los bytes sobrantes al final (si el tamaño no es multiplo de sizeof(T)) se ignoran.
+    // Si no se puede abrir o mapear el archivo el constructor lanza std::system_error
+    template <typename T>
+    requires std::is_trivially_copyable_v<T>
+    class mapped_column {
+        static_assert(std::endian::native == std::endian::little,
+                      "mapped_column lee columnas little-endian sin convertir");
+
+    public:
+        using value_type = T;
+        using iterator = const T*;
+        using const_iterator = const T*;
+
+        explicit mapped_column(const std::string& ruta) {
+            int descriptor = ::open(ruta.c_str(), O_RDONLY | O_CLOEXEC);
+            if (descriptor < 0) {
+                throw std::system_error(errno, std::generic_category(), "mapped_column: open " + ruta);
+            }
+            struct ::stat estado;
+            if (::fstat(descriptor, &estado) != 0) {
+                int error = errno;
+                ::close(descriptor);
+                throw std::system_error(error, std::generic_category(), "mapped_column: fstat " + ruta);
+            }
+            bytes_ = static_cast<std::size_t>(estado.st_size);
+            n_ = bytes_ / sizeof(T);
+
+            // mmap de 0 bytes falla: un archivo vacio es una columna vacia sin mapeo
+            if (bytes_ > 0) {
+                void* mapa = ::mmap(nullptr, bytes_, PROT_READ, MAP_PRIVATE, descriptor, 0);
+                if (mapa == MAP_FAILED) {
+                    int error = errno;
+                    ::close(descriptor);
+                    throw std::system_error(error, std::generic_category(), "mapped_column: mmap " + ruta);
+                }
+                mapa_ = mapa;
+                // Las reducciones leen de principio a fin: el kernel adelanta la lectura y libera
+                // las paginas ya leidas antes. Es solo una pista, si falla se sigue igual
+                ::madvise(mapa_, bytes_, MADV_SEQUENTIAL);
+            }
+            // El mapeo sigue valido despues de cerrar el descriptor
+            ::close(descriptor);
+        }
+
+        mapped_column(const mapped_column&) = delete;
+        mapped_column& operator=(const mapped_column&) = delete;
+
+        mapped_column(mapped_column&& otra) noexcept
+            : mapa_(std::exchange(otra.mapa_, nullptr)), bytes_(std::exchange(otra.bytes_, 0)), n_(std::exchange(otra.n_, 0)) {}
+
+        mapped_column& operator=(mapped_column&& otra) noexcept {
+            if (this != &otra) {
+                liberar();
+                mapa_ = std::exchange(otra.mapa_, nullptr);
+                bytes_ = std::exchange(otra.bytes_, 0);
+                n_ = std::exchange(otra.n_, 0);
+            }
+            return *this;
+        }
+
+        ~mapped_column() { liberar(); }
+
+        const T* data() const noexcept { return static_cast<const T*>(mapa_); }
+        std::size_t size() const noexcept { return n_; }
+        bool empty() const noexcept { return n_ == 0; }
+        const T* begin() const noexcept { return data(); }
+        const T* end() const noexcept { return data() + n_; }
+        const T& operator[](std::size_t i) const noexcept { return data()[i]; }
+
+        // Elementos por trozo paralelo: una pagina (o las necesarias para un numero entero de T).
+        // Asi cada hilo lee paginas enteras y ningun par de hilos comparte una
+        std::size_t chunk_granule() const noexcept {
+            return detail::page_granule<T>();
+        }
+
+    private:
+        void liberar() noexcept {
+            if (mapa_ != nullptr) {
+                ::munmap(mapa_, bytes_);
+                mapa_ = nullptr;
+            }
+        }
+
+        void* mapa_ = nullptr;
+        std::size_t bytes_ = 0;
+        std::size_t n_ = 0;
+    };
+
+    // Tamaño del anillo de column_stream: la memoria usada es buffers * block_bytes
+    struct stream_options {
+        std::size_t block_bytes = std::size_t{1} << 20;
+        unsigned buffers = 4;
+    };
+
+    // column_stream: lee el mismo formato que mapped_column por bloques, sin mapear el archivo.
+    // Un hilo de fondo hace pread de los bloques siguientes a un anillo de buffers alineados a pagina
+    // mientras el hilo que llama reduce el bloque anterior con los kernels, asi la espera del disco
+    // se solapa con el calculo en vez de aparecer como fallos de pagina dentro del bucle.
+    // La memoria esta acotada por el anillo, no por el tamaño del archivo.
+    // Es de una pasada por consulta: cada llamada (sum, describe, ...) vuelve a leer el archivo
+    template <typename T>
+    requires std::is_trivially_copyable_v<T>
+    class column_stream {
+        static_assert(std::endian::native == std::endian::little,
+                      "column_stream lee columnas little-endian sin convertir");
+
+    public:
+        using value_type = T;
+
+        explicit column_stream(const std::string& ruta, stream_options opciones = {}) : ruta_(ruta) {
+            descriptor_ = ::open(ruta.c_str(), O_RDONLY | O_CLOEXEC);
+            if (descriptor_ < 0) {
+                throw std::system_error(errno, std::generic_category(), "column_stream: open " + ruta);
+            }
+            struct ::stat estado;
+            if (::fstat(descriptor_, &estado) != 0) {
+                int error = errno;
+                ::close(descriptor_);
+                throw std::system_error(error, std::generic_category(), "column_stream: fstat " + ruta);
+            }
+            n_ = static_cast<std::size_t>(estado.st_size) / sizeof(T);
+#if defined(POSIX_FADV_SEQUENTIAL)
+            ::posix_fadvise(descriptor_, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+            // Bloques de paginas enteras con un numero entero de T
+            const std::size_t granulo = detail::page_granule<T>();
+            std::size_t por_bloque = opciones.block_bytes / sizeof(T) / granulo * granulo;
+            por_bloque_ = por_bloque > 0 ? por_bloque : granulo;
+            buffers_ = opciones.buffers >= 2 ? opciones.buffers : 2;
+        }
+
+        column_stream(const column_stream&) = delete;
+        column_stream& operator=(const column_stream&) = delete;
+
+        column_stream(column_stream&& otra) noexcept
+            : ruta_(std::move(otra.ruta_)), descriptor_(std::exchange(otra.descriptor_, -1)),
+              n_(std::exchange(otra.n_, 0)), por_bloque_(otra.por_bloque_), buffers_(otra.buffers_) {}
+
+        column_stream& operator=(column_stream&& otra) noexcept {
+            if (this != &otra) {
+                if (descriptor_ >= 0) ::close(descriptor_);
+                ruta_ = std::move(otra.ruta_);
+                descriptor_ = std::exchange(otra.descriptor_, -1);
+                n_ = std::exchange(otra.n_, 0);
+                por_bloque_ = otra.por_bloque_;
+                buffers_ = otra.buffers_;
+            }
+            return *this;
+        }
+
+        ~column_stream() {
+            if (descriptor_ >= 0) ::close(descriptor_);
+        }
+
+        std::size_t size() const noexcept { return n_; }
+        bool empty() const noexcept { return n_ == 0; }
+        std::size_t block_size() const noexcept { return por_bloque_; }
+
+        // Entrega los bloques en orden a funcion(std::span<const T>). El span solo es valido durante la llamada.
+        // Un error de lectura se lanza como std::system_error; si funcion lanza, se detiene la lectura
+        // y la excepcion sale despues de esperar al hilo de fondo
+        template <typename F>
+        requires std::invocable<F&, std::span<const T>>
+        void for_each_block(F funcion) const {
+            if (n_ == 0) return;
+            const std::size_t bloques = (n_ + por_bloque_ - 1) / por_bloque_;
+            const std::size_t bytes_bloque = por_bloque_ * sizeof(T);
+
+            // Un solo bloque de memoria para el anillo, alineado a pagina
+            const std::size_t alineacion = detail::page_granule<T>() * sizeof(T);
+            auto liberar = [](T* p) { ::free(p); };
+            void* memoria = nullptr;
+            if (::posix_memalign(&memoria, alineacion, bytes_bloque * buffers_) != 0) {
+                throw std::bad_alloc();
+            }
+            std::unique_ptr<T, decltype(liberar)> anillo(static_cast<T*>(memoria), liberar);
+
+            // Estado compartido: el productor llena los bloques [consumidos, leidos) del anillo
+            std::mutex cerrojo;
+            std::condition_variable cambio;
+            std::size_t leidos = 0;
+            std::size_t consumidos = 0;
+            bool cancelado = false;
+            int error = 0;
+
+            std::thread lector([&] {
+                for (std::size_t k = 0; k < bloques; ++k) {
+                    {
+                        std::unique_lock<std::mutex> guardia(cerrojo);
+                        cambio.wait(guardia, [&] { return cancelado || leidos - consumidos < buffers_; });
+                        if (cancelado) return;
+                    }
+                    const std::size_t desde = k * por_bloque_;
+                    const std::size_t cantidad = n_ - desde < por_bloque_ ? n_ - desde : por_bloque_;
+                    int resultado = leer(reinterpret_cast<char*>(anillo.get() + (k % buffers_) * por_bloque_),
+                                         cantidad * sizeof(T), static_cast<::off_t>(desde * sizeof(T)));
+                    std::lock_guard<std::mutex> guardia(cerrojo);
+                    if (resultado != 0) {
+                        error = resultado;
+                        cambio.notify_all();
+                        return;
+                    }
+                    ++leidos;
+                    cambio.notify_all();
+                }
+            });
+
+            // Se detiene y espera al lector en cualquier salida, tambien si funcion lanza
+            auto detener = [&] {
+                {
+                    std::lock_guard<std::mutex> guardia(cerrojo);
+                    cancelado = true;
+                }
+                cambio.notify_all();
+                lector.join();
+            };
+
+            try {
+                for (std::size_t k = 0; k < bloques; ++k) {
+                    {
+                        std::unique_lock<std::mutex> guardia(cerrojo);
+                        cambio.wait(guardia, [&] { return error != 0 || leidos > k; });
+                        if (leidos <= k) break;
+                    }
+                    const std::size_t desde = k * por_bloque_;
+                    const std::size_t cantidad = n_ - desde < por_bloque_ ? n_ - desde : por_bloque_;
+                    funcion(std::span<const T>(anillo.get() + (k % buffers_) * por_bloque_, cantidad));
+                    {
+                        std::lock_guard<std::mutex> guardia(cerrojo);
+                        ++consumidos;
+                    }
+                    cambio.notify_all();
+                }
+            } catch (...) {
+                detener();
+                throw;
+            }
+            detener();
+            if (error != 0) {
+                throw std::system_error(error, std::generic_category(), "column_stream: pread " + ruta_);
+            }
+        }
+
+        // Suma ensanchada, como sum, con el kernel de sum sobre cada bloque
+        auto sum() const requires Addable<T> {
+            accumulation_t<T> total{};
+            for_each_block([&](std::span<const T> bloque) { total = total + core_numeric::sum(bloque); });
+            return total;
+        }
+
+        auto mean() const requires detail::Averageable<T> && Addable<T> {
+            return detail::mean_of_sum<T>(sum(), n_);
+        }
+
+        // variance, min y max salen del resumen de una pasada, igual que en las tuberias
+        auto variance() const requires Addable<T> && detail::con_varianza<T> {
+            return summarize().variance();
+        }
+
+        T min() const requires Addable<T> && Comparable<T> {
+            return summarize().min();
+        }
+
+        T max() const requires Addable<T> && Comparable<T> {
+            return summarize().max();
+        }
+
+        summary<T> summarize() const requires Addable<T> {
+            summary<T> resumen;
+            for_each_block([&](std::span<const T> bloque) { resumen.push(bloque); });
+            return resumen;
+        }
+
+        description<T> describe() const requires Addable<T> {
+            return detail::describe_summary(summarize());
+        }
+
+    private:
+        // pread completo: repite ante lecturas cortas e interrupciones. Devuelve 0 o el errno
+        int leer(char* destino, std::size_t bytes, ::off_t posicion) const {
+            while (bytes > 0) {
+                ::ssize_t leido = ::pread(descriptor_, destino, bytes, posicion);
+                if (leido < 0) {
+                    if (errno == EINTR) continue;
+                    return errno;
+                }
+                if (leido == 0) return EIO; // el archivo se acorto mientras se leia
+                destino += leido;
+                bytes -= static_cast<std::size_t>(leido);
+                posicion += leido;
+            }
+            return 0;
+        }
+
+        std::string ruta_;
+        int descriptor_ = -1;
+        std::size_t n_ = 0;
+        std::size_t por_bloque_ = 0;
+        unsigned buffers_ = 2;
+    };
+#endif
 
 } // namespace core_numeric
 
@@ -1,6 +1,15 @@
 #include <iostream>
 #include <vector>
+#include <array>
 #include <string>
+#include <limits>
+#include <ranges>
+#include <sstream>
+#include <fstream>
+#include <cstdio>
+
+// Los tests corren con la instrumentacion activa, asi tambien prueban que compila en los caminos constexpr
+#define CORE_NUMERIC_INSTRUMENT 1
 #include "core_numeric.h"
 
 
@@ -78,14 +87,32 @@ int main() {
     std::cout << "[Vector3D] Media: " << mean_vec << "\n";
     std::cout << "[Vector3D] Max (por magnitud): " << max_vec << "\n";
 
+    // Varianza componente a componente, por defecto en dos pasadas y con Welford en una pasada
+    auto var_vec = core_numeric::variance(v_vec);
+    auto var_vec_1p = core_numeric::variance(v_vec, core_numeric::one_pass);
+    std::cout << "[Vector3D] Varianza: " << var_vec << " | Una pasada: " << var_vec_1p << "\n";
+
     // Test con variadic y fold expressions
     auto s1 = core_numeric::sum_variadic(1, 2, 3, 4);       // Enteros
     auto s2 = core_numeric::mean_variadic(1.0, 2.0, 3.0);   // Flotantes
     auto s3 = core_numeric::max_variadic(10, 5, 20, 1);     // Max variadico
+    constexpr auto s4 = core_numeric::variance_variadic(1.0, 2.0, 3.0, 4.0);  // Varianza en compilacion
+    auto s5 = core_numeric::variance_variadic(1.5, 2.5, 4.0);                 // Varianza sin memoria dinamica
 
     std::cout << "[Variadic] Suma (1,2,3,4): " << s1 << "\n";
     std::cout << "[Variadic] Media (1.0, 2.0, 3.0): " << s2 << "\n";
     std::cout << "[Variadic] Max (10, 5, 20, 1): " << s3 << "\n";
+    std::cout << "[Variadic] Varianza constexpr (1.0, 2.0, 3.0, 4.0): " << s4 << "\n";
+    std::cout << "[Variadic] Varianza (1.5, 2.5, 4.0): " << s5 << "\n";
+
+    // Test en tiempo de compilacion: los algoritmos son constexpr sobre std::array
+    constexpr std::array<double, 5> calibracion = {0.5, 1.5, 2.0, 3.5, 4.5};
+    constexpr double media_calibracion = core_numeric::mean(calibracion);
+    constexpr double varianza_calibracion = core_numeric::variance(calibracion);
+    constexpr double max_calibracion = core_numeric::max(calibracion);
+    static_assert(max_calibracion == 4.5);
+    std::cout << "[Constexpr] Media: " << media_calibracion << " | Varianza: " << varianza_calibracion
+              << " | Max: " << max_calibracion << "\n";
 
     // transform_reduce test
 
@@ -96,6 +123,215 @@ int main() {
     });
     std::cout << "[Transform] Suma de cuadrados: " << tr_res << "\n";
 
+    // Test de los kernels SIMD de sum
+    // Usamos tamaños que no son multiplo del ancho del registro para probar la cola
+    std::vector<float> v_float(1003, 0.5f);
+    std::vector<int> v_int(1001);
+    for (std::size_t i = 0; i < v_int.size(); ++i) {
+        v_int[i] = static_cast<int>(i);
+    }
+    std::cout << "[SIMD] Suma float (1003 x 0.5): " << core_numeric::sum(v_float) << "\n";
+    std::cout << "[SIMD] Suma int (0..1000): " << core_numeric::sum(v_int) << "\n";
+
+    // Test de acumulacion ensanchada: la suma de int32 va en int64 y no desborda,
+    // la media y la varianza de enteros salen exactas (truncadas)
+    std::vector<int> v_contadores(1000, 2'000'000'000);
+    v_contadores.push_back(-5);
+    std::cout << "[Integer] Suma: " << core_numeric::sum(v_contadores)
+              << " | Media: " << core_numeric::mean(v_contadores)
+              << " | Varianza: " << core_numeric::variance(v_contadores)
+              << " | Varianza (0..1000): " << core_numeric::variance(v_int) << "\n";
+
+    // Test de transform_reduce generalizado: acumulador mas ancho que los elementos y otras operaciones
+    std::vector<std::int8_t> v_bytes(1000, 100);
+    auto identidad = [](auto x) { return x; };
+    std::cout << "[TransformReduce] Suma int8 en int32: "
+              << core_numeric::transform_reduce(v_bytes, std::int32_t{0}, std::plus<>{}, identidad)
+              << " | Max de cuadrados: " << core_numeric::transform_reduce(v_int, 0, core_numeric::maximum{}, [](int x) { return x * x; })
+              << " | OR paralelo: " << core_numeric::transform_reduce(core_numeric::execution::par, v_int, 0, std::bit_or<>{}, identidad)
+              << " | Producto float en double: " << core_numeric::transform_reduce(v_float, 1.0, std::multiplies<>{}, identidad) << "\n";
+
+    // maximum con un NaN justo al principio del segundo trozo: seq, par y par_unseq lo ignoran igual que max
+    std::vector<double> v_nan_borde(100000, 1.0);
+    v_nan_borde[50000] = std::numeric_limits<double>::quiet_NaN();
+    v_nan_borde[99999] = 7.0;
+    std::cout << "[TransformReduce] NaN en borde de trozo, seq: "
+              << core_numeric::transform_reduce(v_nan_borde, 0.0, core_numeric::maximum{}, identidad)
+              << " | par: " << core_numeric::transform_reduce(core_numeric::execution::par.with_threads(2), v_nan_borde, 0.0, core_numeric::maximum{}, identidad)
+              << " | par_unseq: " << core_numeric::transform_reduce(core_numeric::execution::par_unseq.with_threads(2), v_nan_borde, 0.0, core_numeric::maximum{}, identidad)
+              << " | max: " << core_numeric::max(core_numeric::execution::par.with_threads(2), v_nan_borde) << "\n";
+
+    // Test de dot y transform_reduce de dos entradas, sin armar un vector de pares
+    std::vector<Vector3D> v_pesos = {Vector3D(2, 2, 2), Vector3D(1, 0, 1), Vector3D(0, 1, 0)};
+    std::array<double, 5> v_invertido = {5.0, 4.0, 3.0, 2.0, 1.0};
+    auto diferencia_cuadrada = [](double x, double y) { return (x - y) * (x - y); };
+    std::cout << "[Dot] double: " << core_numeric::dot(v_double, v_double)
+              << " | int (0..1000): " << core_numeric::dot(v_int, v_int)
+              << " | Vector3D: " << core_numeric::dot(v_vec, v_pesos)
+              << " | Distancia al cuadrado: " << core_numeric::transform_reduce(v_double, v_invertido, 0.0, std::plus<>{}, diferencia_cuadrada) << "\n";
+
+    // Test de rangos: arreglos de C y vistas perezosas se reducen sin copiarlos a un vector
+    double lecturas[] = {2.5, 4.0, 1.5, 8.0};
+    auto pares = v_int | std::views::filter([](int x) { return x % 2 == 0; });
+    auto mitades = v_double | std::views::transform([](double x) { return x / 2; });
+    std::cout << "[Ranges] Arreglo C Media: " << core_numeric::mean(lecturas) << " | Max: " << core_numeric::max(lecturas)
+              << " | Filtro pares Suma: " << core_numeric::sum(pares) << " | Media: " << core_numeric::mean(pares)
+              << " | Transform Varianza: " << core_numeric::variance(mitades) << "\n";
+
+    // Test de rangos de una sola pasada: el stream se consume una vez, contando mientras se acumula
+    std::istringstream tuberia_media("4.0 8.0 15.0 16.0 23.0 42.0");
+    std::istringstream tuberia_varianza("4.0 8.0 15.0 16.0 23.0 42.0");
+    std::istringstream tuberia_enteros("3 -7 11 2000000000");
+    std::cout << "[Stream] Media: " << core_numeric::mean(std::views::istream<double>(tuberia_media))
+              << " | Varianza: " << core_numeric::variance(std::views::istream<double>(tuberia_varianza))
+              << " | Varianza int: " << core_numeric::variance(std::views::istream<int>(tuberia_enteros)) << "\n";
+
+    // Test de extremos con posicion en una pasada: empates -> primera aparicion,
+    // NaN solo se propaga si esta en la primera posicion
+    std::vector<double> v_extremos = {3.0, -1.0, 7.5, 7.5, -1.0, std::numeric_limits<double>::quiet_NaN(), 2.0};
+    auto extremos = core_numeric::minmax(v_extremos);
+    std::cout << "[ArgMax] Max: " << extremos.max.value << " en " << extremos.max.index
+              << " | Min: " << extremos.min.value << " en " << extremos.min.index
+              << " | argmax int: " << core_numeric::argmax(v_int).index
+              << " | argmin Vector3D: " << core_numeric::argmin(v_vec).index << "\n";
+
+    // Varianza en una pasada (por defecto en flotantes) contra la version clasica de dos pasadas
+    std::cout << "[Variance] Una pasada: " << core_numeric::variance(v_double, core_numeric::one_pass)
+              << " | Dos pasadas: " << core_numeric::variance(v_double, core_numeric::two_pass) << "\n";
+
+    // Test del despacho en tiempo de ejecucion: el resultado no depende del kernel elegido
+    // (se puede fijar tambien con la variable de entorno CORE_NUMERIC_ISA)
+    std::cout << "[ISA] Detectado: " << core_numeric::isa_name(core_numeric::detected_isa()) << "\n";
+    for (auto nivel : {core_numeric::isa::scalar, core_numeric::isa::sse42,
+                       core_numeric::isa::avx2, core_numeric::isa::avx512}) {
+        auto usado = core_numeric::set_isa(nivel);
+        std::cout << "[ISA] " << core_numeric::isa_name(usado) << " -> Suma int: " << core_numeric::sum(v_int)
+                  << " | Max int: " << core_numeric::max(v_int) << "\n";
+    }
+    core_numeric::set_isa(core_numeric::detected_isa());
+
+    // Test de las politicas de ejecucion: con pocos elementos par usa un solo hilo,
+    // con muchos reparte en trozos y el resultado debe coincidir con la version secuencial
+    std::vector<double> v_grande(1 << 20);
+    for (std::size_t i = 0; i < v_grande.size(); ++i) {
+        v_grande[i] = static_cast<double>(i % 1000);
+    }
+    auto par4 = core_numeric::execution::par.with_threads(4);
+    std::cout << "[Paralelo] Suma: " << core_numeric::sum(par4, v_grande)
+              << " | Media: " << core_numeric::mean(par4, v_grande)
+              << " | Varianza: " << core_numeric::variance(par4, v_grande)
+              << " | Max: " << core_numeric::max(par4, v_grande) << "\n";
+    std::cout << "[Secuencial] Suma: " << core_numeric::sum(core_numeric::execution::seq, v_grande)
+              << " | Varianza: " << core_numeric::variance(v_grande) << "\n";
+
+    // Test de los modos de suma: magnitudes mezcladas que la suma rapida pierde
+    std::vector<double> v_mixto;
+    for (int i = 0; i < 1000; ++i) {
+        v_mixto.insert(v_mixto.end(), {1e16, 1.0, -1e16});
+    }
+    std::cout << "[Sum] Rapida: " << core_numeric::sum(v_mixto, core_numeric::fast)
+              << " | Por parejas: " << core_numeric::sum(v_mixto, core_numeric::pairwise)
+              << " | KBN: " << core_numeric::sum(v_mixto, core_numeric::kbn)
+              << " | Media KBN: " << core_numeric::mean(v_mixto, core_numeric::kbn) << "\n";
+
+    // Test del acumulador en linea: valores de a uno o por bloques, sin guardar la serie
+    core_numeric::accumulator<double> acc_double;
+    for (double valor : v_double) {
+        acc_double.push(valor);
+    }
+    acc_double.push(std::span<const double>(v_double));
+    std::cout << "[Accumulator] n: " << acc_double.count() << " | Suma: " << acc_double.sum()
+              << " | Media: " << acc_double.mean() << " | Varianza: " << acc_double.variance()
+              << " | Max: " << acc_double.max() << "\n";
+
+    core_numeric::accumulator<Vector3D> acc_vec;
+    for (const auto& v : v_vec) {
+        acc_vec.push(v);
+    }
+    std::cout << "[Accumulator] Vector3D Media: " << acc_vec.mean() << " | Varianza: " << acc_vec.variance()
+              << " | Max: " << acc_vec.max() << "\n";
+
+    // Test de describe: todas las estadisticas en una sola pasada
+    auto descripcion = core_numeric::describe(v_grande);
+    std::cout << "[Describe] n: " << descripcion.count << " | Suma: " << descripcion.sum
+              << " | Media: " << descripcion.mean << " | Varianza: " << descripcion.variance
+              << " | Min: " << descripcion.min << " | Max: " << descripcion.max << "\n";
+    auto descripcion_vec = core_numeric::describe(v_vec);
+    std::cout << "[Describe] Vector3D Media: " << descripcion_vec.mean << " | Max: " << descripcion_vec.max << "\n";
+
+    // Test de resumenes combinables: cada mitad se resume por separado y luego se combinan
+    std::size_t mitad = v_grande.size() / 2;
+    auto resumen_a = core_numeric::summarize(std::vector<double>(v_grande.begin(), v_grande.begin() + mitad));
+    auto resumen_b = core_numeric::summarize(std::vector<double>(v_grande.begin() + mitad, v_grande.end()));
+    auto combinado = core_numeric::merge(resumen_a, resumen_b);
+    std::cout << "[Summary] Combinado n: " << combinado.count() << " | Media: " << combinado.mean()
+              << " | Varianza: " << combinado.variance() << " | Min: " << combinado.min()
+              << " | Max: " << combinado.max() << "\n";
+    std::cout << "[Summary] Paralelo Varianza: " << core_numeric::summarize(par4, v_grande).variance() << "\n";
+
+    // Test de tuberias perezosas: filtro y transformacion fusionados con la reduccion, sin vectores intermedios
+    auto tuberia = core_numeric::from(v_grande)
+                       .filter([](double x) { return x >= 500; })
+                       .map([](double x) { return x / 10; })
+                       .describe();
+    std::cout << "[Pipeline] n: " << tuberia.count << " | Media: " << tuberia.mean << " | Varianza: " << tuberia.variance
+              << " | Min: " << tuberia.min << " | Max: " << tuberia.max
+              << " | Vector3D Suma: " << core_numeric::from(v_vec).filter([](const Vector3D& v) { return v.y > 1; }).sum() << "\n";
+
+    // Test de estructura de arreglos: cada componente de Vector3D en su propia columna
+    core_numeric::soa_vector<Vector3D, &Vector3D::x, &Vector3D::y, &Vector3D::z> soa_vec(v_vec);
+    std::cout << "[SoA] Suma: " << core_numeric::sum(soa_vec) << " | Media: " << core_numeric::mean(soa_vec)
+              << " | Varianza: " << core_numeric::variance(soa_vec) << "\n";
+    std::cout << "[SoA] Max (por componente): " << core_numeric::max(soa_vec) << " | Elemento 2: " << soa_vec[2] << "\n";
+
+    // Test de columna en disco: el archivo binario se mapea con mmap y se reduce sin copiarlo a un vector,
+    // o se lee por bloques con column_stream
+    {
+        const char* ruta_columna = "test_columna.bin";
+        std::ofstream archivo(ruta_columna, std::ios::binary);
+        archivo.write(reinterpret_cast<const char*>(v_double.data()), static_cast<std::streamsize>(v_double.size() * sizeof(double)));
+        archivo.close();
+        core_numeric::mapped_column<double> columna(ruta_columna);
+        std::cout << "[Mapped] n: " << columna.size() << " | Suma: " << core_numeric::sum(columna)
+                  << " | Varianza: " << core_numeric::variance(columna)
+                  << " | Max paralelo: " << core_numeric::max(core_numeric::execution::par, columna) << "\n";
+
+        // El mismo archivo leido por bloques con pread en un hilo de fondo, con bloques de una pagina
+        core_numeric::column_stream<double> flujo(ruta_columna, {4096, 2});
+        auto resumen_flujo = flujo.describe();
+        std::cout << "[ColumnStream] n: " << resumen_flujo.count << " | Suma: " << resumen_flujo.sum
+                  << " | Varianza: " << resumen_flujo.variance << " | Max: " << resumen_flujo.max << "\n";
+        std::remove(ruta_columna);
+    }
+
+    // Test de lotes: muchas series de largos distintos, una grande que se parte en trozos y una vacia
+    {
+        std::vector<std::vector<double>> series = {v_double, {}, v_grande, {10.0, 20.0}};
+        auto lote = core_numeric::describe_batch(par4, series);
+        std::cout << "[Batch] series: " << lote.size() << " | Media 0: " << lote[0].mean << " | n vacia: " << lote[1].count
+                  << " | Varianza grande: " << lote[2].variance << " | Max 3: " << lote[3].max << "\n";
+    }
+
+    // Test de instrumentacion: mean no cuenta ademas un sum, y los hilos de la politica paralela
+    // no cuentan cada trozo como otra llamada
+    {
+        namespace ins = core_numeric::instrumentation;
+        ins::reset();
+        core_numeric::sum(v_int);
+        core_numeric::mean(v_double);
+        core_numeric::mean(v_double);
+        core_numeric::variance(par4, v_grande);
+        auto foto = ins::snapshot();
+        const auto& suma = foto[ins::algorithm::sum];
+        std::size_t kernel = 0;
+        while (suma.kernel_calls[kernel] == 0) ++kernel;
+        std::cout << "[Instrumentation] sum: " << suma.calls << " llamada, " << suma.elements << " elementos, kernel "
+                  << ins::kernel_name(kernel) << " | mean: " << foto[ins::algorithm::mean].calls << " llamadas, "
+                  << foto[ins::algorithm::mean].elements << " elementos | variance paralela: "
+                  << foto[ins::algorithm::variance].calls << " llamada, " << foto[ins::algorithm::variance].elements
+                  << " elementos | ciclos > 0: " << (foto[ins::algorithm::variance].cycles > 0) << "\n";
+    }
+
 
         /*
         